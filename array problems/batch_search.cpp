@@ -0,0 +1,257 @@
+/**
+ * Batch Binary Search: many targets against one sorted array
+ *
+ * Problem: Calling binarySearch once per target costs O(log n) random accesses
+ * per query, O(m log n) in total, and every probe is a likely cache miss on a
+ * large array. When the batch is large, it is cheaper to sort the queries and
+ * resolve them all in one forward pass over the array.
+ *
+ * Approach: Pick a strategy from m / n
+ * - Small batches (m < SMALL_BATCH): independent branchless searches, one per
+ *   query, with no sorting overhead
+ * - Dense batches (n <= DENSE_RATIO * m): sort the queries with mergeSort, then
+ *   one merge-style sweep over the array, O(n + m) sequential accesses
+ * - Sparse batches: sort the queries, then gallop forward from the previous
+ *   answer (exponential search followed by a short binary search),
+ *   O(m log(n / m)) accesses in increasing address order
+ * - Every strategy writes answers back by original query position, so the
+ *   output order always matches the input order
+ *
+ * Result contract matches binarySearch: the index of a matching element, or -1.
+ * (With duplicates, this returns the first occurrence, which is one of the
+ * indices binarySearch may return.)
+ *
+ * Time Complexity: O(m log n), O(m log m + n) or O(m log m + m log(n / m))
+ * Space Complexity: O(m) for the sorted query copy
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+const int SMALL_BATCH = 64;  // below this, sorting the queries is not worth it
+const int DENSE_RATIO = 8;   // n <= 8m: a linear sweep beats galloping
+
+// ==================== REFERENCE (original binary_search.cpp) ====================
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// ==================== QUERY SORTING (mergeSort on (target, position) pairs) ====================
+
+struct Query {
+    int target;
+    int position;  // index in the caller's query array
+
+    bool operator<=(const Query& other) const { return target <= other.target; }
+};
+
+template <typename T>
+void merge(T arr[], int left, int mid, int right, vector<T>& buffer) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    // Left half only; the merge never overtakes unread right-half elements
+    copy(arr + left, arr + mid + 1, buffer.begin());
+    T* L = buffer.data();
+    T* R = arr + mid + 1;
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+}
+
+template <typename T>
+void mergeSort(T arr[], int left, int right, vector<T>& buffer) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid, buffer);
+        mergeSort(arr, mid + 1, right, buffer);
+
+        merge(arr, left, mid, right, buffer);
+    }
+}
+
+// ==================== SEARCH KERNELS ====================
+
+/**
+ * First index in [lo, hi) with arr[index] >= target (hi if none), branchless
+ */
+int lowerBoundBranchless(const int arr[], int lo, int hi, int target) {
+    int len = hi - lo;
+    const int* base = arr + lo;
+    while (len > 1) {
+        int half = len / 2;
+        base = (base[half - 1] < target) ? base + half : base;
+        len -= half;
+    }
+    int idx = base - arr;
+    return (len == 1 && *base < target) ? idx + 1 : idx;
+}
+
+int searchOne(const int arr[], int n, int target) {
+    int idx = lowerBoundBranchless(arr, 0, n, target);
+    return (idx < n && arr[idx] == target) ? idx : -1;
+}
+
+/**
+ * Galloping lower bound starting at `from`: probe from+1, from+3, from+7, ...
+ * until overshooting, then binary search the last gap
+ */
+int gallopLowerBound(const int arr[], int n, int from, int target) {
+    if (from >= n || arr[from] >= target) return from;
+    // 64-bit: past 2^30 elements the doubled step and prev + step overflow int
+    ptrdiff_t step = 1, prev = from;
+    while (prev + step < n && arr[prev + step] < target) {
+        prev += step;
+        step *= 2;
+    }
+    return lowerBoundBranchless(arr, (int)prev + 1, (int)min<ptrdiff_t>(n, prev + step + 1), target);
+}
+
+// ==================== BATCH API ====================
+
+enum class BatchStrategy { PerQuery, Sweep, Gallop };
+
+BatchStrategy chooseStrategy(int n, int m) {
+    if (m < SMALL_BATCH) return BatchStrategy::PerQuery;
+    if ((long long)n <= (long long)DENSE_RATIO * m) return BatchStrategy::Sweep;
+    return BatchStrategy::Gallop;
+}
+
+string strategyName(BatchStrategy s) {
+    switch (s) {
+        case BatchStrategy::PerQuery: return "per-query";
+        case BatchStrategy::Sweep: return "sweep";
+        default: return "gallop";
+    }
+}
+
+/**
+ * Searches every targets[i] in sorted arr[0, n)
+ * @return: result[i] = index of targets[i] in arr, or -1 (original query order)
+ */
+vector<int> batchSearch(int arr[], int n, const int targets[], int m, BatchStrategy strategy) {
+    vector<int> result(m, -1);
+
+    if (strategy == BatchStrategy::PerQuery) {
+        for (int i = 0; i < m; i++)
+            result[i] = searchOne(arr, n, targets[i]);
+        return result;
+    }
+
+    vector<Query> queries(m);
+    for (int i = 0; i < m; i++)
+        queries[i] = {targets[i], i};
+    vector<Query> buffer(m / 2 + 1);
+    mergeSort(queries.data(), 0, m - 1, buffer);
+
+    // Answers only move forward, so each strategy resumes where the last query stopped
+    int pos = 0;
+    for (const Query& q : queries) {
+        if (strategy == BatchStrategy::Sweep) {
+            while (pos < n && arr[pos] < q.target)
+                pos++;
+        } else {
+            pos = gallopLowerBound(arr, n, pos, q.target);
+        }
+        result[q.position] = (pos < n && arr[pos] == q.target) ? pos : -1;
+    }
+    return result;
+}
+
+vector<int> batchSearch(int arr[], int n, const int targets[], int m) {
+    return batchSearch(arr, n, targets, m, chooseStrategy(n, m));
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// binarySearch may return any index of a duplicate: compare found / value
+bool agrees(int arr[], int n, const vector<int>& targets, const vector<int>& got) {
+    for (size_t i = 0; i < targets.size(); i++) {
+        int expected = binarySearch(arr, n, targets[i]);
+        if ((expected == -1) != (got[i] == -1)) return false;
+        if (got[i] != -1 && arr[got[i]] != targets[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    // Test Case 1: the original example, as a batch
+    cout << "Test Case 1:" << endl;
+    int arr[] = {2, 4, 6, 8, 10, 12};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    int targets[] = {10, 3, 2, 12, 13};
+    vector<int> result = batchSearch(arr, n, targets, 5);
+    cout << "Results: ";
+    for (int r : result) cout << r << " ";
+    cout << endl << "Expected: 4 -1 0 5 -1" << endl << endl;
+
+    // Test Case 2: every strategy vs binarySearch, with duplicates and misses
+    cout << "Test Case 2 (all strategies vs binarySearch):" << endl;
+    mt19937 rng(99);
+    bool ok = true;
+    for (int t = 0; t < 300; t++) {
+        int size = rng() % 2000, m = 1 + rng() % 3000;
+        vector<int> a(size);
+        for (int& x : a) x = rng() % (t % 2 ? 50 : 100000);  // odd t: heavy duplicates
+        sort(a.begin(), a.end());
+        vector<int> q(m);
+        for (int& x : q) x = rng() % (t % 2 ? 60 : 100000);
+
+        for (BatchStrategy s : {BatchStrategy::PerQuery, BatchStrategy::Sweep, BatchStrategy::Gallop})
+            ok &= agrees(a.data(), size, q, batchSearch(a.data(), size, q.data(), m, s));
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: timing, 2^24 sorted keys, batch sizes from tiny to dense
+    cout << "Test Case 3 (timing, n = 2^24):" << endl;
+    int big = 1 << 24;
+    vector<int> keys(big);
+    for (int i = 0; i < big; i++) keys[i] = 2 * i;  // even numbers: half the queries miss
+    for (int m : {1000, 100000, 4000000}) {
+        vector<int> q(m);
+        for (int& x : q) x = rng() % (2 * big);
+
+        auto start = chrono::steady_clock::now();
+        [[maybe_unused]] volatile int sink = 0;  // keeps the loop from being optimized away
+        for (int i = 0; i < m; i++) sink = binarySearch(keys.data(), big, q[i]);
+        double loopMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        vector<int> r = batchSearch(keys.data(), big, q.data(), m);
+        double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << "  m=" << m << "  binarySearch loop: " << loopMs << " ms"
+             << "  batch (" << strategyName(chooseStrategy(big, m)) << "): " << batchMs << " ms"
+             << (agrees(keys.data(), big, q, r) ? "" : "  MISMATCH") << endl;
+    }
+
+    return 0;
+}
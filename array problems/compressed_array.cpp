@@ -0,0 +1,328 @@
+/**
+ * Block-Compressed Sorted Array with a Skip Index
+ *
+ * Problem: binarySearch runs over a raw sorted int array, 4 bytes per key.
+ * With billions of keys, little of the set fits in cache (or in RAM), even
+ * though neighbouring sorted keys differ by only a few bits.
+ *
+ * Approach: 128-int blocks, bit-packed, behind an uncompressed skip index
+ * - The array is cut into blocks of BLOCK = 128 keys; the last block is padded
+ *   with its final key. Every block stores its first key ("head") in the skip
+ *   index, plus its bit width and the offset of its packed words
+ * - Codec::Delta4 packs x[i] - x[i - 4] (x[i] - head for the first four).
+ *   Codec::FrameOfReference packs x[i] - head. Either way the block is packed
+ *   at the width of its largest value: 128 * width bits = 4 * width words
+ * - Layout is vertical, 4 lanes: key i goes to lane i % 4, row i / 4, so one
+ *   128-bit load holds the same packed word of all four lanes. SSE2 decoding
+ *   unpacks four keys per shift/mask, and the Delta4 prefix sum is a single
+ *   vector add per row (each lane only depends on itself)
+ * - Lookup: a binary search of the skip heads picks the one block that can
+ *   hold the lower bound. That block is decoded into a 128-int buffer and
+ *   searched with a branchless lower bound, so only one block is decoded
+ *
+ * Result contract matches binarySearch: the index of a matching element, or -1.
+ *
+ * Time Complexity: build O(n); lookup O(log(n / 128)) + O(128) decode
+ * Space Complexity: width / 8 bytes per key + 13 bytes per block of skip index
+ *
+ * Usage: ./compressed_array [log2 n]   (default 2^25 keys)
+ * Build: g++ -std=c++17 -O2 compressed_array.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+const int BLOCK = 128;
+const int LANES = 4;
+const int ROWS = BLOCK / LANES;  // 32 packed values per lane
+
+// ==================== REFERENCE (original binary_search.cpp) ====================
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// ==================== BIT PACKING ====================
+
+int bitWidth(uint32_t x) { return x ? 32 - __builtin_clz(x) : 0; }
+
+/**
+ * Packs 128 values at `width` bits into 4 * width words, vertical 4-lane layout:
+ * value 4k + l sits at bit k * width of lane l, and lane word j is words[4j + l]
+ */
+void pack(const uint32_t values[BLOCK], int width, uint32_t* words) {
+    fill(words, words + LANES * width, 0u);
+    if (width == 0) return;  // every value is 0: nothing stored
+    for (int i = 0; i < BLOCK; i++) {
+        int lane = i % LANES, row = i / LANES;
+        uint64_t bit = (uint64_t)row * width;
+        int j = bit / 32, shift = bit % 32;
+        words[LANES * j + lane] |= values[i] << shift;
+        if (shift + width > 32) words[LANES * (j + 1) + lane] |= values[i] >> (32 - shift);
+    }
+}
+
+/**
+ * Inverse of pack, then adds the block base: FrameOfReference adds head to
+ * every value, Delta4 keeps a running sum per lane starting at head
+ */
+void unpack(const uint32_t* words, int width, int head, bool delta, int out[BLOCK]) {
+#ifdef __SSE2__
+    const __m128i mask = _mm_set1_epi32(width == 32 ? -1 : (int)((1u << width) - 1));
+    __m128i base = _mm_set1_epi32(head);
+    const __m128i* in = (const __m128i*)words;
+    for (int row = 0; row < ROWS; row++) {
+        __m128i v = _mm_setzero_si128();
+        if (width) {
+            int bit = row * width, j = bit / 32, shift = bit % 32;
+            v = _mm_srl_epi32(_mm_loadu_si128(in + j), _mm_cvtsi32_si128(shift));
+            if (shift + width > 32)
+                v = _mm_or_si128(v, _mm_sll_epi32(_mm_loadu_si128(in + j + 1), _mm_cvtsi32_si128(32 - shift)));
+            v = _mm_and_si128(v, mask);
+        }
+        __m128i x = _mm_add_epi32(base, v);
+        if (delta) base = x;
+        _mm_storeu_si128((__m128i*)(out + LANES * row), x);
+    }
+#else
+    uint32_t mask = width == 32 ? ~0u : (1u << width) - 1;
+    uint32_t base[LANES] = {(uint32_t)head, (uint32_t)head, (uint32_t)head, (uint32_t)head};
+    for (int row = 0; row < ROWS; row++) {
+        int bit = row * width, j = bit / 32, shift = bit % 32;
+        for (int lane = 0; lane < LANES; lane++) {
+            uint32_t v = 0;
+            if (width) {
+                v = words[LANES * j + lane] >> shift;
+                if (shift + width > 32) v |= words[LANES * (j + 1) + lane] << (32 - shift);
+                v &= mask;
+            }
+            uint32_t x = base[lane] + v;
+            if (delta) base[lane] = x;
+            out[LANES * row + lane] = (int)x;
+        }
+    }
+#endif
+}
+
+// ==================== COMPRESSED ARRAY ====================
+
+enum class Codec { Delta4, FrameOfReference };
+
+class CompressedSortedArray {
+public:
+    CompressedSortedArray(const int arr[], size_t n, Codec codec = Codec::Delta4)
+        : n(n), delta(codec == Codec::Delta4) {
+        size_t blocks = (n + BLOCK - 1) / BLOCK;
+        heads.reserve(blocks);
+        widths.reserve(blocks);
+        offsets.reserve(blocks + 1);
+        offsets.push_back(0);
+
+        int keys[BLOCK];
+        uint32_t values[BLOCK];
+        for (size_t b = 0; b < blocks; b++) {
+            size_t first = b * BLOCK, count = min<size_t>(BLOCK, n - first);
+            copy(arr + first, arr + first + count, keys);
+            fill(keys + count, keys + BLOCK, keys[count - 1]);  // pad the last block
+
+            uint32_t widest = 0;
+            for (int i = 0; i < BLOCK; i++) {
+                int base = (delta && i >= LANES) ? keys[i - LANES] : keys[0];
+                values[i] = (uint32_t)keys[i] - (uint32_t)base;
+                widest |= values[i];
+            }
+            int width = bitWidth(widest);
+
+            heads.push_back(keys[0]);
+            widths.push_back(width);
+            words.resize(offsets.back() + LANES * width);
+            pack(values, width, words.data() + offsets.back());
+            offsets.push_back(words.size());
+        }
+        words.shrink_to_fit();
+    }
+
+    size_t size() const { return n; }
+    size_t blockCount() const { return heads.size(); }
+
+    // Packed words plus the skip index (heads, widths, offsets)
+    size_t bytes() const {
+        return words.size() * 4 + heads.size() * 4 + widths.size() + offsets.size() * 8;
+    }
+
+    void decodeBlock(size_t b, int out[BLOCK]) const {
+        unpack(words.data() + offsets[b], widths[b], heads[b], delta, out);
+    }
+
+    int get(size_t i) const {
+        int block[BLOCK];
+        decodeBlock(i / BLOCK, block);
+        return block[i % BLOCK];
+    }
+
+    // First index with value >= target (n if none)
+    size_t lowerBound(int target) const {
+        int value;
+        return find(target, value);
+    }
+
+    // Index of an element equal to target, or -1 (same contract as binarySearch)
+    long long binarySearch(int target) const {
+        int value;
+        size_t i = find(target, value);
+        return (i < n && value == target) ? (long long)i : -1;
+    }
+
+    vector<int> decodeAll() const {
+        vector<int> out(blockCount() * BLOCK);
+        for (size_t b = 0; b < blockCount(); b++) decodeBlock(b, out.data() + b * BLOCK);
+        out.resize(n);
+        return out;
+    }
+
+private:
+    /**
+     * Lower bound of target, decoding one block; value receives the key at
+     * the returned index when it is < n
+     */
+    size_t find(int target, int& value) const {
+        if (n == 0) return 0;
+        // Last block whose head is < target; the lower bound is in it or is the next head
+        size_t b = lower_bound(heads.begin(), heads.end(), target) - heads.begin();
+        if (b == 0) {
+            value = heads[0];
+            return 0;
+        }
+        b--;
+
+        alignas(16) int block[BLOCK];
+        decodeBlock(b, block);
+        const int* base = block;
+        int len = BLOCK;
+        while (len > 1) {
+            int half = len / 2;
+            base = (base[half - 1] < target) ? base + half : base;
+            len -= half;
+        }
+        int slot = (base - block) + (*base < target ? 1 : 0);
+        size_t i = b * BLOCK + slot;
+        if (i >= n) return n;
+        value = (slot < BLOCK) ? block[slot] : heads[b + 1];
+        return i;
+    }
+
+    size_t n;
+    bool delta;
+    vector<int> heads;         // skip index: first key of every block
+    vector<uint8_t> widths;    // bits per packed value
+    vector<uint64_t> offsets;  // first packed word of every block (+ end)
+    vector<uint32_t> words;    // packed blocks
+};
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// n sorted keys with gaps drawn uniformly from [0, 2 * meanGap]
+vector<int> sortedKeys(size_t n, uint32_t meanGap, mt19937& rng) {
+    vector<int> keys(n);
+    int64_t x = INT_MIN;
+    for (size_t i = 0; i < n; i++) {
+        x += rng() % (2 * meanGap + 1);
+        keys[i] = (int)min<int64_t>(x, INT_MAX);
+    }
+    return keys;
+}
+
+int main(int argc, char* argv[]) {
+    int logN = (argc > 1) ? atoi(argv[1]) : 25;
+    mt19937 rng(48);
+
+    // Test Case 1: a small array with duplicates and a partial last block
+    cout << "Test Case 1:" << endl;
+    vector<int> small;
+    for (int i = 0; i < 300; i++) small.push_back(i / 3 * 7 - 500);
+    CompressedSortedArray c1(small.data(), small.size());
+    cout << "blocks=" << c1.blockCount() << " get(299)=" << c1.get(299) << " find(-493)=" << c1.binarySearch(-493)
+         << " find(-492)=" << c1.binarySearch(-492) << endl;
+    cout << "Expected: blocks=3 get(299)=193 find(-493)=3..5 find(-492)=-1" << endl;
+    long long f = c1.binarySearch(-493);
+    bool ok1 = c1.blockCount() == 3 && c1.get(299) == 193 && f >= 3 && f <= 5 && c1.binarySearch(-492) == -1;
+    cout << (ok1 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: both codecs round-trip and agree with binarySearch on every shape
+    cout << "Test Case 2 (round trip + lookups vs binarySearch):" << endl;
+    bool ok2 = true;
+    for (int t = 0; t < 300; t++) {
+        size_t n = rng() % 2000;
+        uint32_t gap = (t % 4 == 0) ? 0 : (t % 4 == 1) ? 3 : (t % 4 == 2) ? 100000 : 1u << 30;
+        vector<int> keys = sortedKeys(n, gap, rng);
+        if (t % 5 == 0 && n) keys.back() = INT_MAX;
+        for (Codec codec : {Codec::Delta4, Codec::FrameOfReference}) {
+            CompressedSortedArray c(keys.data(), n, codec);
+            ok2 &= c.decodeAll() == keys;
+            for (int q = 0; q < 40; q++) {
+                int target = (n && q % 2) ? keys[rng() % n] + (q % 4 == 1 ? 1 : 0) : (int)rng();
+                long long got = c.binarySearch(target);
+                int ref = binarySearch(keys.data(), n, target);
+                ok2 &= (ref < 0) ? got < 0 : (got >= 0 && keys[got] == target);
+                ok2 &= c.lowerBound(target) == (size_t)(lower_bound(keys.begin(), keys.end(), target) - keys.begin());
+            }
+        }
+    }
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: memory and lookup time at scale
+    size_t n = (size_t)1 << logN;
+    const int queries = 2000000;
+    cout << "Test Case 3 (" << n << " keys, " << queries << " lookups):" << endl;
+    bool ok3 = true;
+    for (uint32_t gap : {8u, 64u}) {
+        vector<int> keys = sortedKeys(n, gap, rng);
+        vector<int> targets(queries);
+        for (int& t : targets) t = keys[rng() % n];
+
+        long long sink = 0;
+        auto start = chrono::steady_clock::now();
+        for (int t : targets) sink += binarySearch(keys.data(), n, t);
+        double rawNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / queries;
+
+        for (Codec codec : {Codec::Delta4, Codec::FrameOfReference}) {
+            CompressedSortedArray c(keys.data(), n, codec);
+            start = chrono::steady_clock::now();
+            for (int t : targets) sink += c.binarySearch(t);
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / queries;
+            double ratio = (double)n * 4 / c.bytes();
+            for (int q = 0; q < 1000; q++) ok3 &= keys[c.binarySearch(targets[q])] == targets[q];
+            cout << "  mean gap " << setw(2) << gap << ", " << setw(6)
+                 << (codec == Codec::Delta4 ? "delta4" : "FOR") << ": " << fixed << setprecision(2) << ratio
+                 << "x smaller (" << c.bytes() / (1 << 20) << " MB vs " << n * 4 / (1 << 20) << " MB), "
+                 << setprecision(0) << ns << " ns/lookup vs " << rawNs << " ns raw" << endl;
+            if (gap == 8 && codec == Codec::Delta4) ok3 &= ratio >= 3;
+        }
+        if (sink == 42) cout << endl;
+    }
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl;
+    return 0;
+}
@@ -0,0 +1,689 @@
+/**
+ * Randomized Differential Tests for mergeSort and binarySearch
+ *
+ * Problem: Every optimized sort or search variant must behave exactly like the
+ * reference mergeSort / binarySearch, on every input shape, at every size.
+ * Hand-written examples in main() do not cover duplicates, presorted runs or
+ * sizes in the millions.
+ *
+ * Approach: Generate, diff, shrink
+ * - Generators produce arrays of a given size and shape: uniform random,
+ *   sorted, reversed, sawtooth, organ pipe, few unique values (adversarial
+ *   duplicates) and all-equal. Sizes scale up to 10^7.
+ * - Each candidate runs on a copy of the input and is compared with the
+ *   reference. Sort results must be identical. Search candidates answer a
+ *   batch of targets per array; each answer must agree on found / not found,
+ *   and a returned index must hold the target (binarySearch returns an
+ *   arbitrary match among duplicates).
+ * - When a case fails, the input is shrunk: remove chunks (halves, quarters,
+ *   down to single elements), then shrink values toward 0, keeping each
+ *   change only while the failure persists. The minimal input is printed.
+ *
+ * Candidates are the real variant files, not copies: each .cpp is included
+ * into a namespace of its own (see VARIANTS UNDER TEST), so their merge(),
+ * mergeSort() and main() do not collide. To cover a new variant, include its
+ * file the same way and add it to sortCandidates() / searchCandidates().
+ * std::stable_sort and std::lower_bound stay registered as a check on the
+ * harness itself.
+ *
+ * Usage: ./differential_test [maxN] [seed]     (default maxN = 100000)
+ * Build: g++ -std=c++17 -O2 -pthread differential_test.cpp
+ *
+ * Note: the reference merge() uses stack arrays (VLAs) of n/2 ints, so the
+ * tests run on a thread with a large stack.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <map>
+#include <set>
+#include <string>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <immintrin.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include "../tools/alloc_counter.h"  // variants that count heap use share one operator new
+using namespace std;
+
+// ==================== VARIANTS UNDER TEST ====================
+// Every standard header the variants use is included above, so the include
+// guards keep them out of these namespaces; only the variants' own code lands
+// inside.
+
+namespace radix_sort {
+#include "radix_sort.cpp"
+}
+
+namespace simd_mergesort {
+#include "simd_mergesort.cpp"
+}
+
+namespace batch_search {
+#include "batch_search.cpp"
+}
+
+namespace learned_index {
+#include "learned_index.cpp"
+}
+
+namespace search_bounds {
+#include "search_bounds.cpp"
+}
+
+namespace inplace_mergesort {
+#include "inplace_mergesort.cpp"
+}
+
+namespace kway_merge {
+#include "kway_merge.cpp"
+}
+
+namespace partial_sort {
+#include "partial_sort.cpp"
+}
+
+namespace key_payload_sort {
+#include "key_payload_sort.cpp"
+}
+
+namespace external_sort {
+#include "external_sort.cpp"
+}
+
+namespace compressed_array {
+#include "compressed_array.cpp"
+}
+
+namespace bst_bulk_build {
+#include "../tree problems/hard/bst_bulk_build.cpp"
+}
+
+
+// ==================== REFERENCE IMPLEMENTATIONS (unchanged) ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// ==================== CANDIDATES ====================
+
+struct SortCandidate {
+    string name;
+    function<void(int arr[], int n)> sort;
+};
+
+/**
+ * A search candidate answers a whole batch of targets on one sorted array:
+ * result[i] is an index holding targets[i], or -1. Batches let batch APIs run
+ * their real strategies and let index structures be built once per array
+ */
+struct SearchCandidate {
+    string name;
+    function<vector<int>(int arr[], int n, const vector<int>& targets)> search;
+};
+
+SearchCandidate perTarget(string name, function<int(int arr[], int n, int target)> one) {
+    return {name, [one](int arr[], int n, const vector<int>& targets) {
+        vector<int> result;
+        for (int t : targets) result.push_back(one(arr, n, t));
+        return result;
+    }};
+}
+
+vector<SortCandidate> sortCandidates() {
+    vector<SortCandidate> candidates = {
+        {"std::stable_sort", [](int arr[], int n) { stable_sort(arr, arr + n); }},
+        {"radix_sort::mergeSort", [](int arr[], int n) { radix_sort::mergeSort(arr, 0, n - 1); }},
+        {"radix_sort::radixSort<8>", [](int arr[], int n) { radix_sort::radixSort<8>(arr, n); }},
+        {"radix_sort::radixSort (parallel histogram)", [](int arr[], int n) {
+            radix_sort::radixSort(arr, n, true);
+        }},
+    };
+
+    // inplace_mergesort.cpp: both merge modes
+    for (auto mode : {inplace_mergesort::MergeMode::Buffered, inplace_mergesort::MergeMode::InPlace}) {
+        string label = mode == inplace_mergesort::MergeMode::InPlace ? "in-place" : "buffered";
+        candidates.push_back({"inplace_mergesort::mergeSort (" + label + ")", [mode](int arr[], int n) {
+            inplace_mergesort::mergeSort(arr, 0, n - 1, mode);
+        }});
+    }
+
+    // kway_merge.cpp: cut the input into shards, sort each one, merge them back.
+    // 2 shards take the two-way path, more take the loser tree, and threads > 1
+    // takes the splitter path once the input passes its 2^16 cutoff
+    for (int shards : {1, 2, 3, 16, 257}) {
+        for (unsigned threads : {1u, 4u}) {
+            if (threads > 1 && shards < 3) continue;
+            string name = "kway_merge::" + string(threads > 1 ? "kWayMergeParallel" : "kWayMerge") + " (k=" +
+                          to_string(shards) + (threads > 1 ? ", 4 threads)" : ")");
+            candidates.push_back({name, [shards, threads](int arr[], int n) {
+                vector<vector<int>> parts(shards);
+                for (int s = 0; s < shards; s++) {
+                    parts[s].assign(arr + (long long)n * s / shards, arr + (long long)n * (s + 1) / shards);
+                    stable_sort(parts[s].begin(), parts[s].end());
+                }
+                if (threads > 1)
+                    kway_merge::kWayMergeParallel(kway_merge::spansOf(parts), arr, threads);
+                else
+                    kway_merge::kWayMerge(kway_merge::spansOf(parts), arr);
+            }});
+        }
+    }
+
+    // partial_sort.cpp: a partial sort (or top-k) of the first k, then a sort of
+    // the rest, is a full sort only if the select put exactly the k smallest
+    // in front
+    for (int div : {1, 3, 1000}) {
+        candidates.push_back({"partial_sort::partialMergeSort (k=n/" + to_string(div) + ")", [div](int arr[], int n) {
+            int k = n / div;
+            partial_sort::partialMergeSort(arr, n, k);
+            partial_sort::partialMergeSort(arr + k, n - k, n - k);
+        }});
+        candidates.push_back({"partial_sort::topK + introSelect (k=n/" + to_string(div) + ")", [div](int arr[], int n) {
+            int k = n / div;
+            vector<int> smallest = partial_sort::topK(arr, n, k);
+            partial_sort::introSelect(arr, n, k);
+            copy(smallest.begin(), smallest.end(), arr);
+            partial_sort::partialMergeSort(arr + k, n - k, n - k);
+        }});
+    }
+
+    // key_payload_sort.cpp: the permutation sort with each way of applying it
+    auto identity = [](int x) { return x; };
+    candidates.push_back({"key_payload_sort::applyPermutation", [identity](int arr[], int n) {
+        vector<size_t> perm = key_payload_sort::sortPermutation(arr, n, identity);
+        vector<int> src(arr, arr + n);
+        key_payload_sort::applyPermutation(src.data(), arr, perm);
+    }});
+    candidates.push_back({"key_payload_sort::applyPermutationInPlace", [identity](int arr[], int n) {
+        key_payload_sort::applyPermutationInPlace(arr, key_payload_sort::sortPermutation(arr, n, identity));
+    }});
+
+    // external_sort.cpp: about 7 runs merged 3 at a time (two passes), with
+    // checkpoints inside the groups; once straight through, once preempted
+    // after a few checkpoints and then resumed
+    for (bool preempt : {false, true}) {
+        candidates.push_back({string("external_sort::externalSort") + (preempt ? " (preempted, resumed)" : ""),
+                              [preempt](int arr[], int n) {
+            char tmpl[] = "/tmp/difftestXXXXXX";
+            if (!mkdtemp(tmpl)) return;
+            string base = tmpl, input = base + "/input.bin", output = base + "/output.bin", work = base + "/work";
+            external_sort::writeInts(input, vector<int>(arr, arr + n));
+
+            external_sort::SortOptions options;
+            options.runElements = max(16, n / 7 + 1);
+            options.fanIn = 3;
+            options.checkpointElements = max(8, n / 5);
+            external_sort::SortReport first, second;
+            if (preempt) {
+                external_sort::SortOptions stop = options;
+                stop.preemptAfter = 4;
+                if (!external_sort::externalSort(input, output, work, stop, first))
+                    external_sort::externalSort(input, output, work, options, second);
+            } else {
+                external_sort::externalSort(input, output, work, options, first);
+            }
+
+            // A failed sort leaves a short or missing output: report a strictly
+            // decreasing array, which no sorted input matches
+            vector<int> sorted = external_sort::readInts(output);
+            if (sorted.size() == (size_t)n)
+                copy(sorted.begin(), sorted.end(), arr);
+            else
+                for (int i = 0; i < n; i++) arr[i] = n - i;
+            external_sort::removeWorkDirectory(work);
+            unlink(input.c_str());
+            unlink(output.c_str());
+            rmdir(base.c_str());
+        }});
+    }
+
+    // compressed_array.cpp: sorted, packed with each codec, decoded back
+    for (auto codec : {compressed_array::Codec::Delta4, compressed_array::Codec::FrameOfReference}) {
+        string label = codec == compressed_array::Codec::Delta4 ? "delta4" : "frame-of-reference";
+        candidates.push_back({"compressed_array::decodeAll (" + label + ")", [codec](int arr[], int n) {
+            stable_sort(arr, arr + n);
+            vector<int> decoded = compressed_array::CompressedSortedArray(arr, n, codec).decodeAll();
+            copy(decoded.begin(), decoded.end(), arr);
+        }});
+    }
+
+    // simd_mergesort.cpp: every merge kernel this CPU can run
+    for (const simd_mergesort::MergeKernel* kernel :
+         {&simd_mergesort::scalarKernel, &simd_mergesort::avx2Kernel, &simd_mergesort::avx512Kernel}) {
+        if (!simd_mergesort::supported(kernel)) continue;
+        candidates.push_back({"simd_mergesort::mergeSort (" + kernel->name + ")", [kernel](int arr[], int n) {
+            const simd_mergesort::MergeKernel* saved = simd_mergesort::activeKernel;
+            simd_mergesort::activeKernel = kernel;
+            simd_mergesort::mergeSort(arr, 0, n - 1);
+            simd_mergesort::activeKernel = saved;
+        }});
+    }
+    return candidates;
+}
+
+vector<SearchCandidate> searchCandidates() {
+    vector<SearchCandidate> candidates = {
+        perTarget("std::lower_bound", [](int arr[], int n, int target) {
+            int* it = lower_bound(arr, arr + n, target);
+            return (it != arr + n && *it == target) ? (int)(it - arr) : -1;
+        }),
+        perTarget("batch_search::searchOne", batch_search::searchOne),
+        {"batch_search::batchSearch (auto)", [](int arr[], int n, const vector<int>& targets) {
+            return batch_search::batchSearch(arr, n, targets.data(), targets.size());
+        }},
+    };
+
+    // learned_index.cpp: the model is trained once per array, then queried
+    candidates.push_back({"learned_index::LearnedIndex::search", [](int arr[], int n, const vector<int>& targets) {
+        learned_index::LearnedIndex index(arr, n);
+        vector<int> result;
+        for (int t : targets) result.push_back(index.search(t));
+        return result;
+    }});
+
+    // search_bounds.cpp: both occurrence queries, and the lockstep batch kernel
+    // with lower (strict = false) and upper (strict = true) bounds
+    candidates.push_back(perTarget("search_bounds::firstOccurrence", search_bounds::firstOccurrence));
+    candidates.push_back(perTarget("search_bounds::lastOccurrence", search_bounds::lastOccurrence));
+    for (bool strict : {false, true}) {
+        candidates.push_back({string("search_bounds::boundBatch (") + (strict ? "upper" : "lower") + ")",
+                              [strict](int arr[], int n, const vector<int>& targets) {
+            int m = targets.size();
+            vector<int> result(m);
+            for (int start = 0; start < m; start += search_bounds::BATCH_LANES) {
+                int count = min(search_bounds::BATCH_LANES, m - start);
+                search_bounds::boundBatch(arr, n, targets.data() + start, count, strict, result.data() + start);
+            }
+            // Upper bounds point one past the last copy, lower bounds at the first
+            for (int i = 0; i < m; i++) {
+                int at = strict ? result[i] - 1 : result[i];
+                result[i] = (at >= 0 && at < n && arr[at] == targets[i]) ? at : -1;
+            }
+            return result;
+        }});
+    }
+
+    // compressed_array.cpp: each codec, built once per array; binarySearch, and
+    // lowerBound checked through get()
+    for (auto codec : {compressed_array::Codec::Delta4, compressed_array::Codec::FrameOfReference}) {
+        string label = codec == compressed_array::Codec::Delta4 ? "delta4" : "frame-of-reference";
+        candidates.push_back({"compressed_array::binarySearch (" + label + ")",
+                              [codec](int arr[], int n, const vector<int>& targets) {
+            compressed_array::CompressedSortedArray packed(arr, n, codec);
+            vector<int> result;
+            for (int t : targets) result.push_back((int)packed.binarySearch(t));
+            return result;
+        }});
+        candidates.push_back({"compressed_array::lowerBound (" + label + ")",
+                              [codec](int arr[], int n, const vector<int>& targets) {
+            compressed_array::CompressedSortedArray packed(arr, n, codec);
+            vector<int> result;
+            for (int t : targets) {
+                size_t i = packed.lowerBound(t);
+                // A wrong bound reports index n, which the checker rejects
+                if (i != (size_t)(lower_bound(arr, arr + n, t) - arr)) result.push_back(n);
+                else result.push_back(i < (size_t)n && packed.get(i) == t ? (int)i : -1);
+            }
+            return result;
+        }});
+    }
+
+    // bst_bulk_build.cpp: each layout, built on 1 and 3 threads. The tree must
+    // hold the array in order, and lowerBound must agree with std::lower_bound
+    for (auto layout : {bst_bulk_build::BstLayout::Preorder, bst_bulk_build::BstLayout::Eytzinger}) {
+        for (unsigned threads : {1u, 3u}) {
+            string label = string(layout == bst_bulk_build::BstLayout::Preorder ? "preorder" : "eytzinger")
+                         + ", " + to_string(threads) + " thread" + (threads > 1 ? "s" : "");
+            candidates.push_back({"bst_bulk_build::BulkBst::contains (" + label + ")",
+                                  [layout, threads](int arr[], int n, const vector<int>& targets) {
+                bst_bulk_build::BulkBst tree = bst_bulk_build::buildBalancedBst(arr, n, layout, threads);
+                // A wrong tree or bound reports index n, which the checker rejects
+                bool inOrder = bst_bulk_build::inorder(tree.root()) == vector<int>(arr, arr + n);
+                vector<int> result;
+                for (int t : targets) {
+                    const int* key = tree.lowerBound(t);
+                    int* it = lower_bound(arr, arr + n, t);
+                    bool sameBound = (key == nullptr) == (it == arr + n) && (!key || *key == *it);
+                    if (!inOrder || !sameBound) result.push_back(n);
+                    else result.push_back(tree.contains(t) ? (int)(it - arr) : -1);
+                }
+                return result;
+            }});
+        }
+    }
+
+    // batch_search.cpp: every strategy forced, whatever chooseStrategy() would pick
+    for (auto strategy : {batch_search::BatchStrategy::PerQuery, batch_search::BatchStrategy::Sweep,
+                          batch_search::BatchStrategy::Gallop}) {
+        candidates.push_back({"batch_search::batchSearch (" + batch_search::strategyName(strategy) + ")",
+                              [strategy](int arr[], int n, const vector<int>& targets) {
+                                  return batch_search::batchSearch(arr, n, targets.data(), targets.size(), strategy);
+                              }});
+    }
+    return candidates;
+}
+
+// ==================== GENERATORS ====================
+
+struct Generator {
+    string name;
+    function<vector<int>(int n, mt19937& rng)> make;
+};
+
+vector<Generator> generators() {
+    return {
+        {"uniform", [](int n, mt19937& rng) {
+            vector<int> a(n);
+            uniform_int_distribution<int> d(-1000000000, 1000000000);
+            for (int& x : a) x = d(rng);
+            return a;
+        }},
+        {"sorted", [](int n, mt19937& rng) {
+            vector<int> a(n);
+            int v = -n;
+            for (int& x : a) x = (v += rng() % 3);
+            return a;
+        }},
+        {"reversed", [](int n, mt19937& rng) {
+            vector<int> a(n);
+            int v = n;
+            for (int& x : a) x = (v -= rng() % 3);
+            return a;
+        }},
+        {"sawtooth", [](int n, mt19937& rng) {
+            vector<int> a(n);
+            int period = 1 + rng() % 64;
+            for (int i = 0; i < n; i++) a[i] = i % period;
+            return a;
+        }},
+        {"organ pipe", [](int n, mt19937&) {
+            vector<int> a(n);
+            for (int i = 0; i < n; i++) a[i] = min(i, n - 1 - i);
+            return a;
+        }},
+        {"few unique", [](int n, mt19937& rng) {
+            vector<int> a(n);
+            for (int& x : a) x = rng() % 4;
+            return a;
+        }},
+        {"all equal", [](int n, mt19937&) {
+            return vector<int>(n, 7);
+        }},
+    };
+}
+
+// ==================== DIFF + SHRINK ====================
+
+/**
+ * Shrink a failing input while `fails` still returns true.
+ * Pass 1 removes chunks of decreasing size, pass 2 pulls values toward 0.
+ */
+vector<int> shrink(vector<int> input, const function<bool(const vector<int>&)>& fails) {
+    for (size_t chunk = input.size() / 2; chunk >= 1; chunk /= 2) {
+        for (size_t start = 0; start + chunk <= input.size();) {
+            vector<int> smaller(input.begin(), input.begin() + start);
+            smaller.insert(smaller.end(), input.begin() + start + chunk, input.end());
+            if (fails(smaller))
+                input = smaller;
+            else
+                start += chunk;
+        }
+    }
+
+    for (size_t i = 0; i < input.size(); i++) {
+        while (input[i] != 0) {
+            vector<int> simpler = input;
+            simpler[i] /= 2;
+            if (!fails(simpler)) break;
+            input = simpler;
+        }
+    }
+    return input;
+}
+
+void printArray(const vector<int>& a) {
+    cout << "[";
+    for (size_t i = 0; i < a.size(); i++) {
+        cout << a[i];
+        if (i + 1 < a.size()) cout << ",";
+    }
+    cout << "]";
+}
+
+bool sortDiffers(const SortCandidate& c, const vector<int>& input) {
+    vector<int> expected = input, got = input;
+    if (!expected.empty()) mergeSort(expected.data(), 0, expected.size() - 1);
+    c.sort(got.data(), got.size());
+    return expected != got;
+}
+
+/**
+ * Query targets for a sorted array: every present value in a sample, plus
+ * values in the gaps and beyond both ends
+ */
+vector<int> searchTargets(const vector<int>& sorted, mt19937& rng) {
+    vector<int> targets = {INT32_MIN, INT32_MAX, 0};
+    if (sorted.empty()) return targets;
+    for (int k = 0; k < 64; k++) {
+        int v = sorted[rng() % sorted.size()];
+        targets.push_back(v);
+        targets.push_back(v - 1);
+        targets.push_back(v + 1);
+    }
+    return targets;
+}
+
+/**
+ * Position in targets of the first answer that disagrees with binarySearch,
+ * or -1 when the whole batch agrees
+ */
+int searchDiffers(const SearchCandidate& c, const vector<int>& sorted, const vector<int>& targets) {
+    // Searches only read the array; no copy, so 10^7-element cases stay cheap
+    int* a = const_cast<int*>(sorted.data());
+    int n = sorted.size();
+    vector<int> got = c.search(a, n, targets);
+    if (got.size() != targets.size()) return 0;
+    for (size_t i = 0; i < targets.size(); i++) {
+        int expected = binarySearch(a, n, targets[i]);
+        if ((expected == -1) != (got[i] == -1)) return i;
+        if (got[i] != -1 && (got[i] < 0 || got[i] >= n || a[got[i]] != targets[i])) return i;
+    }
+    return -1;
+}
+
+// Sorted inputs for search come from the reference sort
+vector<int> sortedCopy(vector<int> a) {
+    if (!a.empty()) mergeSort(a.data(), 0, a.size() - 1);
+    return a;
+}
+
+int failures = 0;
+
+void runSortDiffs(const vector<int>& sizes, unsigned seed) {
+    for (const SortCandidate& c : sortCandidates()) {
+        for (const Generator& g : generators()) {
+            for (int n : sizes) {
+                mt19937 rng(seed + n);
+                vector<int> input = g.make(n, rng);
+                if (!sortDiffers(c, input)) continue;
+
+                failures++;
+                auto fails = [&](const vector<int>& v) { return sortDiffers(c, v); };
+                cout << "  FAILED ✗ " << c.name << " on " << g.name << " n=" << n << endl;
+                cout << "    shrunk input: ";
+                printArray(shrink(input, fails));
+                cout << endl;
+                break;
+            }
+        }
+        cout << "  " << c.name << " checked" << endl;
+    }
+}
+
+void runSearchDiffs(const vector<int>& sizes, unsigned seed) {
+    for (const SearchCandidate& c : searchCandidates()) {
+        for (const Generator& g : generators()) {
+            for (int n : sizes) {
+                mt19937 rng(seed + n);
+                vector<int> sorted = sortedCopy(g.make(n, rng));
+
+                vector<int> targets = searchTargets(sorted, rng);
+                int bad = searchDiffers(c, sorted, targets);
+                if (bad < 0) continue;
+
+                // Shrink the array with the same batch, so batch strategies stay the same
+                failures++;
+                auto fails = [&](const vector<int>& v) { return searchDiffers(c, sortedCopy(v), targets) >= 0; };
+                cout << "  FAILED ✗ " << c.name << " on " << g.name << " n=" << n
+                     << " target=" << targets[bad] << endl;
+                cout << "    shrunk input: ";
+                printArray(sortedCopy(shrink(sorted, fails)));
+                cout << endl;
+            }
+        }
+        cout << "  " << c.name << " checked" << endl;
+    }
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+struct Options {
+    int maxN;
+    unsigned seed;
+};
+
+void* runAll(void* arg) {
+    Options opt = *(Options*)arg;
+
+    // Small sizes catch edge cases, then grow by 10x up to maxN
+    vector<int> sizes = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100};
+    for (long long n = 1000; n <= opt.maxN; n *= 10)
+        sizes.push_back(n);
+    if (sizes.back() != opt.maxN && opt.maxN > 100)
+        sizes.push_back(opt.maxN);
+
+    cout << "Test Case 1: sort candidates vs mergeSort" << endl;
+    runSortDiffs(sizes, opt.seed);
+    cout << endl;
+
+    cout << "Test Case 2: search candidates vs binarySearch" << endl;
+    runSearchDiffs(sizes, opt.seed);
+    cout << endl;
+
+    // Test Case 3: the shrinker itself, on a deliberately broken sort that
+    // loses the last element whenever the input has a duplicate
+    cout << "Test Case 3: shrinker self-check (broken candidate)" << endl;
+    SortCandidate broken = {"broken", [](int arr[], int n) {
+        stable_sort(arr, arr + n);
+        for (int i = 1; i < n; i++)
+            if (arr[i] == arr[i - 1]) { arr[n - 1] = 0; break; }
+    }};
+    mt19937 rng(opt.seed);
+    vector<int> input = generators()[5].make(1000, rng);  // "few unique"
+    vector<int> minimal = shrink(input, [&](const vector<int>& v) { return sortDiffers(broken, v); });
+    cout << "  Shrunk from " << input.size() << " to " << minimal.size() << " elements: ";
+    printArray(minimal);
+    cout << endl << "  Expected: 2 equal non-zero elements, e.g. [1,1]" << endl;
+    bool shrunkOk = minimal.size() == 2 && minimal[0] == minimal[1] && minimal[0] != 0 &&
+                    sortDiffers(broken, minimal);
+    if (!shrunkOk) failures++;
+    cout << "  " << (shrunkOk ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt = {100000, 12345};
+    if (argc > 1) opt.maxN = min(atoi(argv[1]), 10000000);
+    if (argc > 2) opt.seed = strtoul(argv[2], nullptr, 10);
+
+    cout << "=== Differential Tests (maxN=" << opt.maxN << ", seed=" << opt.seed << ") ===" << endl << endl;
+
+    // The reference merge() needs ~2 * n ints of stack at the top level
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)opt.maxN * 2 * sizeof(int) + (64 << 20));
+    pthread_t worker;
+    pthread_create(&worker, &attr, runAll, &opt);
+    pthread_join(worker, nullptr);
+    pthread_attr_destroy(&attr);
+
+    if (failures == 0)
+        cout << "=== All Differential Tests PASSED ✓ ===" << endl;
+    else
+        cout << "=== " << failures << " Differential Test(s) FAILED ✗ ===" << endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,660 @@
+/**
+ * Checkpointable, Resumable External Merge Sort
+ *
+ * Problem: Out-of-core sorts of multi-GB int files take hours. When the job is
+ * preempted, all of that work is lost and the sort restarts from scratch.
+ *
+ * Approach: External merge sort whose progress lives in a small manifest
+ * - Run phase: the input is read runElements ints at a time, each chunk is
+ *   stably sorted in memory and written to run-<id>.bin in the work directory.
+ *   After every run the manifest records how much input has been consumed
+ * - Merge phase: passes merge up to fanIn consecutive runs into one new run
+ *   through a min-heap, with ties going to the earlier run, so the result
+ *   equals a stable sort of the whole input (mergeSort semantics). After
+ *   every group the manifest moves the group's inputs out and its output in.
+ *   Every checkpointElements outputs inside a group, the manifest also records
+ *   the output length and each input's read position
+ * - Durability: a run or output is fsync'ed before the manifest names it, and
+ *   the manifest is replaced atomically (write manifest.tmp, fsync, rename),
+ *   so after a crash the manifest always describes files that are complete
+ * - Resume: externalSort() loads the manifest if it matches the input size and
+ *   the parameters. It then skips the consumed input, or truncates the active
+ *   merge output to its last checkpoint and seeks every input back to its
+ *   position. File ids come from the manifest, so a run half-written before a
+ *   crash is simply overwritten
+ * - Cleanup: an input run is deleted only after the manifest stops naming it.
+ *   The final run is renamed to the output path, and the manifest and work
+ *   directory are removed
+ * - SortOptions::preemptAfter is a crash-injection hook for tests: the sort
+ *   stops right after that many checkpoints, as if killed
+ *
+ * I/O failures and invalid options (runElements or checkpointElements of 0,
+ * fanIn below 2) set SortReport::error and the call returns false; rerunning
+ * after an I/O failure resumes from the last checkpoint.
+ *
+ * Time Complexity: O(N log N) compares, O(N * (1 + passes)) I/O, passes = ceil(log_fanIn(runs))
+ * Space Complexity: O(runElements) memory + O(fanIn * READ_BUFFER) buffers
+ *
+ * Usage: ./external_sort input.bin output.bin workdir [memoryMB] [fanIn]
+ *        ./external_sort   (self-test)
+ * Build: g++ -std=c++17 -O2 external_sort.cpp
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <queue>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dirent.h>
+using namespace std;
+
+const size_t READ_BUFFER = 1 << 16;  // ints buffered per merge input
+const char* MANIFEST = "manifest";
+
+struct SortOptions {
+    size_t runElements = 1 << 22;         // ints sorted in memory per run (16 MB)
+    size_t fanIn = 16;                    // runs merged at once
+    size_t checkpointElements = 1 << 24;  // merge outputs between checkpoints
+    long long preemptAfter = -1;          // test hook: stop after this many checkpoints
+};
+
+struct SortReport {
+    bool resumed = false;
+    bool preempted = false;
+    size_t runsWritten = 0;     // by this call
+    size_t groupsMerged = 0;    // by this call
+    size_t checkpoints = 0;     // by this call
+    size_t elements = 0;
+    double seconds = 0;
+    string error;  // empty on success
+};
+
+// ==================== MANIFEST ====================
+
+/**
+ * Progress of one sort. Text, one "key values..." line per field
+ */
+struct Manifest {
+    uint64_t inputElements = 0;
+    uint64_t runElements = 0, fanIn = 0;
+    uint64_t consumed = 0;   // input ints already written to runs
+    uint64_t nextId = 0;     // next run file id
+    vector<uint64_t> inputs;   // runs of the current pass still to merge, in order
+    vector<uint64_t> outputs;  // runs produced by the current pass, in order
+
+    // The group being merged (active == false when between groups)
+    bool active = false;
+    uint64_t activeOutput = 0, written = 0;
+    vector<uint64_t> positions;  // per inputs[0..group) ints consumed
+
+    string text() const {
+        ostringstream out;
+        out << "extsort 1\n";
+        out << "input_elements " << inputElements << "\n";
+        out << "run_elements " << runElements << "\n";
+        out << "fan_in " << fanIn << "\n";
+        out << "consumed " << consumed << "\n";
+        out << "next_id " << nextId << "\n";
+        out << "inputs";
+        for (uint64_t id : inputs) out << " " << id;
+        out << "\noutputs";
+        for (uint64_t id : outputs) out << " " << id;
+        out << "\nactive " << active << " " << activeOutput << " " << written;
+        for (uint64_t p : positions) out << " " << p;
+        out << "\n";
+        return out.str();
+    }
+
+    static bool parse(const string& text, Manifest& m) {
+        istringstream in(text);
+        string line, key;
+        if (!getline(in, line) || line != "extsort 1") return false;
+        auto ids = [](istringstream& fields, vector<uint64_t>& to) {
+            uint64_t id;
+            while (fields >> id) to.push_back(id);
+        };
+        int seen = 0;
+        while (getline(in, line)) {
+            istringstream fields(line);
+            fields >> key;
+            seen++;
+            if (key == "input_elements") fields >> m.inputElements;
+            else if (key == "run_elements") fields >> m.runElements;
+            else if (key == "fan_in") fields >> m.fanIn;
+            else if (key == "consumed") fields >> m.consumed;
+            else if (key == "next_id") fields >> m.nextId;
+            else if (key == "inputs") ids(fields, m.inputs);
+            else if (key == "outputs") ids(fields, m.outputs);
+            else if (key == "active") {
+                fields >> m.active >> m.activeOutput >> m.written;
+                ids(fields, m.positions);
+            } else return false;
+        }
+        return seen == 8;
+    }
+};
+
+// ==================== FILE HELPERS ====================
+
+string runPath(const string& dir, uint64_t id) {
+    char name[32];
+    snprintf(name, sizeof(name), "/run-%06llu.bin", (unsigned long long)id);
+    return dir + name;
+}
+
+bool syncFile(FILE* f) {
+    return fflush(f) == 0 && fsync(fileno(f)) == 0;
+}
+
+bool syncDirectory(const string& dir) {
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+// Atomic replace: write manifest.tmp, fsync it, rename over manifest, fsync the directory
+bool saveManifest(const string& dir, const Manifest& m) {
+    string tmp = dir + "/" + MANIFEST + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    string text = m.text();
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size() && syncFile(f);
+    ok &= fclose(f) == 0;
+    return ok && rename(tmp.c_str(), (dir + "/" + MANIFEST).c_str()) == 0 && syncDirectory(dir);
+}
+
+bool loadManifest(const string& dir, Manifest& m) {
+    ifstream in(dir + "/" + MANIFEST);
+    if (!in) return false;
+    stringstream text;
+    text << in.rdbuf();
+    return Manifest::parse(text.str(), m);
+}
+
+// Removes the sort's own files (run-*.bin, manifest*) from dir, then dir if empty
+void removeWorkDirectory(const string& dir) {
+    if (DIR* d = opendir(dir.c_str())) {
+        while (dirent* e = readdir(d))
+            if (strncmp(e->d_name, "run-", 4) == 0 || strncmp(e->d_name, MANIFEST, strlen(MANIFEST)) == 0)
+                unlink((dir + "/" + e->d_name).c_str());
+        closedir(d);
+    }
+    rmdir(dir.c_str());
+}
+
+long long fileSize(const string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+// ==================== IN-MEMORY RUN SORT ====================
+
+/**
+ * Stable bottom-up merge sort (the merge of mergesort.cpp, with one heap
+ * buffer instead of per-call VLAs, which would overflow the stack at run size)
+ */
+void sortRun(vector<int>& a, vector<int>& buffer) {
+    size_t n = a.size();
+    buffer.resize(n);
+    int* src = a.data();
+    int* dst = buffer.data();
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = min(n, lo + width), hi = min(n, lo + 2 * width);
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) dst[k++] = (src[i] <= src[j]) ? src[i++] : src[j++];
+            while (i < mid) dst[k++] = src[i++];
+            while (j < hi) dst[k++] = src[j++];
+        }
+        swap(src, dst);
+    }
+    if (src != a.data()) copy(src, src + n, a.data());
+}
+
+// ==================== EXTERNAL SORT ====================
+
+class ExternalSorter {
+public:
+    ExternalSorter(const string& dir, const SortOptions& options, SortReport& report)
+        : dir(dir), options(options), report(report) {}
+
+    bool run(const string& inputPath, const string& outputPath) {
+        // Zero-sized runs or checkpoints, or a fan-in of 1, would never finish
+        if (options.runElements == 0) return fail("runElements must be at least 1");
+        if (options.fanIn < 2) return fail("fanIn must be at least 2");
+        if (options.checkpointElements == 0) return fail("checkpointElements must be at least 1");
+
+        long long bytes = fileSize(inputPath);
+        if (bytes < 0 || bytes % 4) return fail("cannot read input " + inputPath + " (missing or not int32)");
+        report.elements = bytes / 4;
+
+        mkdir(dir.c_str(), 0755);
+        Manifest saved;
+        if (loadManifest(dir, saved) && saved.inputElements == report.elements &&
+            saved.runElements == options.runElements && saved.fanIn == options.fanIn) {
+            m = saved;
+            report.resumed = true;
+        } else {
+            // Missing, corrupt or from another job: start over
+            removeWorkDirectory(dir);
+            if (mkdir(dir.c_str(), 0755) != 0) return fail("cannot create " + dir);
+            m = Manifest();
+            m.inputElements = report.elements;
+            m.runElements = options.runElements;
+            m.fanIn = options.fanIn;
+            if (!checkpoint()) return false;
+        }
+
+        if (m.consumed < m.inputElements && !writeRuns(inputPath)) return false;
+        while (m.inputs.size() + m.outputs.size() > 1 || m.active) {
+            if (m.inputs.empty()) {
+                m.inputs.swap(m.outputs);  // next pass
+                continue;
+            }
+            if (!mergeGroup()) return false;
+        }
+
+        // One run left (or none, for an empty input): it becomes the output
+        vector<uint64_t> last = m.outputs.empty() ? m.inputs : m.outputs;
+        if (last.empty()) {
+            FILE* f = fopen(outputPath.c_str(), "wb");
+            if (!f || fclose(f) != 0) return fail("cannot write " + outputPath);
+        } else if (rename(runPath(dir, last[0]).c_str(), outputPath.c_str()) != 0) {
+            return fail("cannot move the result to " + outputPath);
+        }
+        removeWorkDirectory(dir);
+        return true;
+    }
+
+private:
+    bool fail(const string& message) {
+        if (report.error.empty()) report.error = message;
+        return false;
+    }
+
+    // Saves the manifest; false (preempted) once the test hook's budget is used up
+    bool checkpoint() {
+        if (!saveManifest(dir, m)) return fail("cannot write manifest in " + dir);
+        report.checkpoints++;
+        if (options.preemptAfter >= 0 && (long long)report.checkpoints > options.preemptAfter) {
+            report.preempted = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool writeRuns(const string& inputPath) {
+        FILE* in = fopen(inputPath.c_str(), "rb");
+        if (!in) return fail("cannot open " + inputPath);
+        if (fseeko(in, (off_t)m.consumed * 4, SEEK_SET) != 0) {
+            fclose(in);
+            return fail("cannot seek in " + inputPath);
+        }
+
+        vector<int> chunk, buffer;
+        bool ok = true;
+        while (ok && m.consumed < m.inputElements) {
+            chunk.resize(min<uint64_t>(m.runElements, m.inputElements - m.consumed));
+            if (fread(chunk.data(), 4, chunk.size(), in) != chunk.size()) {
+                ok = fail("short read from " + inputPath);
+                break;
+            }
+            sortRun(chunk, buffer);
+
+            uint64_t id = m.nextId;
+            FILE* out = fopen(runPath(dir, id).c_str(), "wb");
+            ok = out && fwrite(chunk.data(), 4, chunk.size(), out) == chunk.size() && syncFile(out);
+            if (out) ok &= fclose(out) == 0;
+            if (!ok) {
+                fail("cannot write " + runPath(dir, id));
+                break;
+            }
+
+            m.nextId++;
+            m.consumed += chunk.size();
+            m.outputs.push_back(id);
+            report.runsWritten++;
+            ok = checkpoint();
+        }
+        fclose(in);
+        return ok;
+    }
+
+    struct Reader {
+        FILE* file = nullptr;
+        vector<int> buffer;
+        size_t pos = 0, len = 0;
+
+        bool next(int& value) {
+            if (pos == len) {
+                len = fread(buffer.data(), 4, buffer.size(), file);
+                pos = 0;
+                if (len == 0) return false;
+            }
+            value = buffer[pos++];
+            return true;
+        }
+    };
+
+    // Merges the first min(fanIn, inputs) runs into one, resuming a checkpointed group
+    bool mergeGroup() {
+        size_t group = min<size_t>(m.fanIn, m.inputs.size());
+        if (group == 1 && !m.active) {
+            // A lone leftover run moves to the next pass without being copied
+            m.outputs.push_back(m.inputs[0]);
+            m.inputs.erase(m.inputs.begin());
+            return checkpoint();
+        }
+        if (!m.active) {
+            m.active = true;
+            m.activeOutput = m.nextId++;
+            m.written = 0;
+            m.positions.assign(group, 0);
+        }
+
+        vector<Reader> readers(group);
+        FILE* out = fopen(runPath(dir, m.activeOutput).c_str(), m.written ? "r+b" : "wb");
+        bool ok = out != nullptr;
+        // Drop whatever was written after the last checkpoint
+        ok = ok && ftruncate(fileno(out), (off_t)m.written * 4) == 0 && fseeko(out, (off_t)m.written * 4, SEEK_SET) == 0;
+        for (size_t r = 0; ok && r < group; r++) {
+            readers[r].file = fopen(runPath(dir, m.inputs[r]).c_str(), "rb");
+            readers[r].buffer.resize(READ_BUFFER);
+            ok = readers[r].file && fseeko(readers[r].file, (off_t)m.positions[r] * 4, SEEK_SET) == 0;
+        }
+
+        // (value, run): ties go to the earlier run, which keeps the merge stable
+        typedef pair<int, size_t> Head;
+        priority_queue<Head, vector<Head>, greater<Head>> heap;
+        int value;
+        for (size_t r = 0; ok && r < group; r++)
+            if (readers[r].next(value)) heap.push({value, r});
+
+        vector<int> pending;
+        pending.reserve(READ_BUFFER);
+        uint64_t sinceCheckpoint = 0;
+        while (ok && !heap.empty()) {
+            Head top = heap.top();
+            heap.pop();
+            pending.push_back(top.first);
+            m.positions[top.second]++;
+            if (readers[top.second].next(value)) heap.push({value, top.second});
+
+            // Also flush at a checkpoint boundary, so checkpoints land exactly
+            // every checkpointElements outputs, not at the next full buffer
+            bool dueCheckpoint = sinceCheckpoint + pending.size() >= options.checkpointElements;
+            if (pending.size() == READ_BUFFER || heap.empty() || dueCheckpoint) {
+                ok = fwrite(pending.data(), 4, pending.size(), out) == pending.size();
+                m.written += pending.size();
+                sinceCheckpoint += pending.size();
+                pending.clear();
+            }
+            if (ok && !heap.empty() && sinceCheckpoint >= options.checkpointElements) {
+                ok = syncFile(out) || fail("cannot sync merge output");
+                ok = ok && checkpoint();
+                sinceCheckpoint = 0;
+            }
+        }
+        if (ok && out) ok = syncFile(out) || fail("cannot sync merge output");
+        if (out) fclose(out);
+        for (Reader& r : readers)
+            if (r.file) fclose(r.file);
+        if (!ok) return report.preempted ? false : fail("merge of group into run " + to_string(m.activeOutput) + " failed");
+
+        // Group done: the manifest forgets its inputs before they are deleted
+        vector<uint64_t> done(m.inputs.begin(), m.inputs.begin() + group);
+        m.inputs.erase(m.inputs.begin(), m.inputs.begin() + group);
+        m.outputs.push_back(m.activeOutput);
+        m.active = false;
+        m.positions.clear();
+        m.written = 0;
+        report.groupsMerged++;
+        bool saved = checkpoint();
+        if (!saved && !report.preempted) return false;
+        for (uint64_t id : done) unlink(runPath(dir, id).c_str());
+        return saved;
+    }
+
+    string dir;
+    SortOptions options;
+    SortReport& report;
+    Manifest m;
+};
+
+/**
+ * Sorts the int32 file inputPath into outputPath, keeping progress in workDir.
+ * Call again after a failure or preemption to resume
+ */
+bool externalSort(const string& inputPath, const string& outputPath, const string& workDir,
+                  const SortOptions& options, SortReport& report) {
+    auto start = chrono::steady_clock::now();
+    bool ok = ExternalSorter(workDir, options, report).run(inputPath, outputPath);
+    report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return ok;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+bool writeInts(const string& path, const vector<int>& values) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(values.data(), 4, values.size(), f) == values.size();
+    return fclose(f) == 0 && ok;
+}
+
+vector<int> readInts(const string& path) {
+    long long bytes = fileSize(path);
+    vector<int> values(bytes > 0 ? bytes / 4 : 0);
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f) {
+        if (fread(values.data(), 4, values.size(), f) != values.size()) values.clear();
+        fclose(f);
+    }
+    return values;
+}
+
+vector<int> sortedCopy(vector<int> values) {
+    if (!values.empty()) mergeSort(values.data(), 0, values.size() - 1);
+    return values;
+}
+
+bool exists(const string& path) { return fileSize(path) >= 0; }
+
+int main(int argc, char* argv[]) {
+    if (argc >= 4) {
+        SortOptions options;
+        if (argc > 4) options.runElements = (size_t)max(1, atoi(argv[4])) << 18;  // MB -> ints
+        if (argc > 5) options.fanIn = max(2, atoi(argv[5]));
+        SortReport report;
+        bool ok = externalSort(argv[1], argv[2], argv[3], options, report);
+        cout << (report.resumed ? "resumed, " : "") << report.elements << " ints, " << report.runsWritten
+             << " runs, " << report.groupsMerged << " merges, " << report.seconds << " s" << endl;
+        if (!ok) cout << "error: " << report.error << endl;
+        return ok ? 0 : 1;
+    }
+
+    char tmpl[] = "/tmp/extsortXXXXXX";
+    string base = mkdtemp(tmpl);
+    string input = base + "/input.bin", output = base + "/output.bin", work = base + "/work";
+    mt19937 rng(47);
+
+    // Test Case 1: 20 ints, runs of 4, fan-in 2 (5 runs, 3 merge passes)
+    cout << "Test Case 1:" << endl;
+    vector<int> small = {38, 27, 43, 3, 9, 82, 10, -5, 27, 0, 12, 43, -100, 7, 7, 64, 1, 2, 99, -1};
+    writeInts(input, small);
+    SortOptions tiny;
+    tiny.runElements = 4;
+    tiny.fanIn = 2;
+    SortReport r1;
+    bool ok1 = externalSort(input, output, work, tiny, r1);
+    vector<int> got = readInts(output);
+    cout << "Output: ";
+    for (size_t i = 0; i < got.size(); i++) cout << got[i] << (i + 1 < got.size() ? " " : "");
+    cout << endl << "runs=" << r1.runsWritten << " merges=" << r1.groupsMerged << endl;
+    ok1 &= got == sortedCopy(small) && r1.runsWritten == 5 && r1.groupsMerged == 4 && !exists(work);
+    cout << (ok1 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: preempted after every possible checkpoint, then resumed
+    cout << "Test Case 2 (preempt after each checkpoint k, then resume):" << endl;
+    vector<int> medium(5000);
+    for (int& x : medium) x = (int)(rng() % 300) - 150;
+    writeInts(input, medium);
+    vector<int> expected = sortedCopy(medium);
+    SortOptions opts;
+    opts.runElements = 512;
+    opts.fanIn = 3;
+    opts.checkpointElements = 700;
+    SortReport full;
+    externalSort(input, output, work, opts, full);
+    bool ok2 = readInts(output) == expected;
+    size_t totalCheckpoints = full.checkpoints, midMerge = 0;
+    for (size_t k = 0; k < totalCheckpoints; k++) {
+        unlink(output.c_str());
+        SortOptions stop = opts;
+        stop.preemptAfter = k;
+        SortReport first, second;
+        bool finished = externalSort(input, output, work, stop, first);
+        ok2 &= !finished && first.preempted && exists(work + "/" + MANIFEST);
+
+        // Stopped inside a group: append garbage after the checkpointed
+        // output, as a crash between two checkpoints would leave it. It is
+        // longer than anything the resumed merge writes, so only truncation
+        // gets rid of it
+        Manifest state;
+        if (loadManifest(work, state) && state.active && state.written > 0) {
+            midMerge++;
+            FILE* f = fopen(runPath(work, state.activeOutput).c_str(), "ab");
+            vector<int> garbage(medium.size(), 999999);
+            ok2 &= f && fwrite(garbage.data(), 4, garbage.size(), f) == garbage.size();
+            if (f) fclose(f);
+        }
+        ok2 &= externalSort(input, output, work, opts, second) && second.resumed;
+        ok2 &= readInts(output) == expected && !exists(work);
+        // Resuming never redoes a completed run
+        ok2 &= first.runsWritten + second.runsWritten == full.runsWritten;
+    }
+    cout << "  " << totalCheckpoints << " checkpoints in a full sort, each one preempted and resumed ("
+         << midMerge << " inside a merge group)" << endl;
+    ok2 &= midMerge > 0;
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: a crash between writing a run and saving the manifest leaves
+    // a stray file; a stale manifest of another job is ignored
+    cout << "Test Case 3 (stray run file, stale manifest):" << endl;
+    SortOptions stop = opts;
+    stop.preemptAfter = 3;
+    SortReport a, b, c;
+    externalSort(input, output, work, stop, a);
+    Manifest m;
+    loadManifest(work, m);
+    writeInts(runPath(work, m.nextId), vector<int>(100, 12345));  // half-done run the manifest never saw
+    bool ok3 = externalSort(input, output, work, opts, b) && b.resumed && readInts(output) == expected;
+
+    externalSort(input, output, work, stop, a);
+    vector<int> other(3000);
+    for (int& x : other) x = (int)rng();
+    writeInts(input, other);  // different input, same work directory
+    ok3 &= externalSort(input, output, work, opts, c) && !c.resumed && readInts(output) == sortedCopy(other);
+    ok3 &= !exists(work);
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: errors are reported, not thrown
+    cout << "Test Case 4 (missing input, invalid options):" << endl;
+    SortReport missing;
+    bool ok4 = !externalSort(base + "/nope.bin", output, work, opts, missing) && !missing.error.empty();
+    cout << "error: " << missing.error << endl;
+    writeInts(input, small);
+    for (int bad = 0; bad < 3; bad++) {
+        SortOptions invalid = tiny;
+        if (bad == 0) invalid.runElements = 0;
+        if (bad == 1) invalid.fanIn = 1;
+        if (bad == 2) invalid.checkpointElements = 0;
+        SortReport rejected;
+        ok4 &= !externalSort(input, output, work, invalid, rejected) && !rejected.error.empty() && !exists(work);
+        cout << "error: " << rejected.error << endl;
+    }
+    cout << (ok4 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: 2^24 ints with 4 MB runs, uninterrupted vs preempted halfway
+    const size_t big = 1 << 24;
+    cout << "Test Case 5 (" << big << " ints, 4 MB runs, fan-in 16):" << endl;
+    vector<int> data(big);
+    for (int& x : data) x = (int)rng();
+    writeInts(input, data);
+    vector<int>().swap(data);
+    SortOptions large;
+    large.runElements = 1 << 20;
+    large.checkpointElements = 1 << 22;
+    SortReport once;
+    bool ok5 = externalSort(input, output, work, large, once);
+    vector<int> result = readInts(output);
+    ok5 &= result.size() == big && is_sorted(result.begin(), result.end());
+    cout << "  uninterrupted: " << once.seconds << " s, " << once.checkpoints << " checkpoints, "
+         << big * 4 / once.seconds / 1e6 << " MB/s" << endl;
+
+    SortOptions half = large;
+    half.preemptAfter = once.checkpoints / 2;
+    SortReport part1, part2;
+    externalSort(input, output, work, half, part1);
+    ok5 &= externalSort(input, output, work, large, part2) && part2.resumed;
+    ok5 &= readInts(output) == result;
+    cout << "  preempted at checkpoint " << half.preemptAfter << ": " << part1.seconds << " s + resume "
+         << part2.seconds << " s" << endl;
+    cout << (ok5 ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    unlink(input.c_str());
+    unlink(output.c_str());
+    rmdir(base.c_str());
+    return 0;
+}
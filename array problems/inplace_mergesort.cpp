@@ -0,0 +1,268 @@
+/**
+ * In-Place Stable Merge Sort (O(1) auxiliary memory)
+ *
+ * Problem: merge() copies both halves into L and R, so sorting needs O(n) extra
+ * memory. On a memory-capped container, a 40 GB array cannot get another 20 GB
+ * of buffer space.
+ *
+ * Approach: Rotation-based merge (SymMerge) with a small fixed buffer
+ * - SymMerge (Kim & Kutzner) merges two adjacent sorted runs without a buffer.
+ *   A binary search finds a split point symmetric around the middle, one
+ *   std::rotate (in place) exchanges the two inner blocks, and the two
+ *   resulting sub-problems are merged recursively
+ * - When the shorter run has at most INPLACE_BUFFER elements, it is copied into
+ *   a fixed-size stack buffer and merged linearly (forward or backward)
+ * - Runs of at most INSERTION_RUN elements are sorted with insertion sort
+ * - Every step keeps equal elements in their original order, so the sort is
+ *   stable, like mergeSort
+ * - Selected with MergeMode::InPlace; MergeMode::Buffered is the original
+ *   algorithm (L / R copies, O(n) memory)
+ *
+ * Peak memory: input + INPLACE_BUFFER elements + O(log^2 n) recursion frames
+ *
+ * Time Complexity: Buffered O(n log n); InPlace O(n log^2 n) worst case
+ * Space Complexity: Buffered O(n); InPlace O(1) heap
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstddef>
+#include <algorithm>
+#include "../tools/alloc_counter.h"  // g_alloc: live and peak heap bytes per mode
+using namespace std;
+
+const int INPLACE_BUFFER = 128;  // elements in the fixed merge buffer (stack)
+const int INSERTION_RUN = 16;    // runs up to this length use insertion sort
+
+enum class MergeMode { Buffered, InPlace };
+
+// Indices are ptrdiff_t: the point of this file is arrays too large for a
+// second copy, and sums like mid + m pass INT_MAX well before memory runs out
+
+// ==================== BUFFERED MODE (original merge) ====================
+
+template <typename T>
+void mergeBuffered(T arr[], ptrdiff_t left, ptrdiff_t mid, ptrdiff_t right) {
+    ptrdiff_t n1 = mid - left + 1;
+    ptrdiff_t n2 = right - mid;
+
+    vector<T> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    ptrdiff_t i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (!(R[j] < L[i]))
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+// ==================== IN-PLACE MODE ====================
+
+template <typename T>
+void insertionSort(T arr[], ptrdiff_t left, ptrdiff_t right) {
+    for (ptrdiff_t i = left + 1; i <= right; i++) {
+        T key = arr[i];
+        ptrdiff_t j = i - 1;
+        while (j >= left && key < arr[j]) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * Merge arr[a, m) and arr[m, b) when the shorter side fits in a fixed buffer
+ */
+template <typename T>
+void mergeSmallBuffer(T arr[], ptrdiff_t a, ptrdiff_t m, ptrdiff_t b) {
+    T buffer[INPLACE_BUFFER];
+
+    if (m - a <= b - m) {
+        // Left side into the buffer, merge forward
+        ptrdiff_t n1 = m - a;
+        copy(arr + a, arr + m, buffer);
+        ptrdiff_t i = 0, j = m, k = a;
+        while (i < n1 && j < b) {
+            if (!(arr[j] < buffer[i]))
+                arr[k++] = buffer[i++];
+            else
+                arr[k++] = arr[j++];
+        }
+        while (i < n1)
+            arr[k++] = buffer[i++];
+    } else {
+        // Right side into the buffer, merge backward (ties keep the left element first)
+        ptrdiff_t n2 = b - m;
+        copy(arr + m, arr + b, buffer);
+        ptrdiff_t i = m - 1, j = n2 - 1, k = b - 1;
+        while (i >= a && j >= 0) {
+            if (buffer[j] < arr[i])
+                arr[k--] = arr[i--];
+            else
+                arr[k--] = buffer[j--];
+        }
+        while (j >= 0)
+            arr[k--] = buffer[j--];
+    }
+}
+
+/**
+ * Stable in-place merge of arr[a, m) and arr[m, b) (SymMerge)
+ */
+template <typename T>
+void symMerge(T arr[], ptrdiff_t a, ptrdiff_t m, ptrdiff_t b) {
+    if (a >= m || m >= b) return;
+
+    // Already in order: nothing to merge
+    if (!(arr[m] < arr[m - 1])) return;
+
+    if (min(m - a, b - m) <= (ptrdiff_t)INPLACE_BUFFER) {
+        mergeSmallBuffer(arr, a, m, b);
+        return;
+    }
+
+    // Find the split `start` so that arr[start, m) and arr[m, end) can be
+    // swapped by one rotation, symmetric around mid
+    ptrdiff_t mid = a + (b - a) / 2;
+    ptrdiff_t n = mid + m;
+    ptrdiff_t start, r;
+    if (m > mid) {
+        start = n - b;
+        r = mid;
+    } else {
+        start = a;
+        r = m;
+    }
+    ptrdiff_t p = n - 1;
+    while (start < r) {
+        ptrdiff_t c = start + (r - start) / 2;
+        if (!(arr[p - c] < arr[c]))
+            start = c + 1;
+        else
+            r = c;
+    }
+    ptrdiff_t end = n - start;
+
+    if (start < m && m < end)
+        rotate(arr + start, arr + m, arr + end);
+
+    if (a < start && start < mid)
+        symMerge(arr, a, start, mid);
+    if (mid < end && end < b)
+        symMerge(arr, mid, end, b);
+}
+
+// ==================== MERGE SORT ====================
+
+/**
+ * Sorts arr[left..right] (inclusive), stable in both modes
+ */
+template <typename T>
+void mergeSort(T arr[], ptrdiff_t left, ptrdiff_t right, MergeMode mode = MergeMode::Buffered) {
+    if (left >= right) return;
+
+    if (mode == MergeMode::InPlace && right - left + 1 <= INSERTION_RUN) {
+        insertionSort(arr, left, right);
+        return;
+    }
+
+    ptrdiff_t mid = left + (right - left) / 2;
+
+    mergeSort(arr, left, mid, mode);
+    mergeSort(arr, mid + 1, right, mode);
+
+    if (mode == MergeMode::InPlace)
+        symMerge(arr, left, mid + 1, right + 1);
+    else
+        mergeBuffered(arr, left, mid, right);
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Key + original position; ordering looks at the key only
+struct Record {
+    int key;
+    int position;
+    bool operator<(const Record& other) const { return key < other.key; }
+};
+
+bool stableSorted(const vector<Record>& v) {
+    for (size_t i = 1; i < v.size(); i++) {
+        if (v[i].key < v[i - 1].key) return false;
+        if (v[i].key == v[i - 1].key && v[i].position < v[i - 1].position) return false;
+    }
+    return true;
+}
+
+int main() {
+    // Test Case 1: the original example
+    cout << "Test Case 1:" << endl;
+    int arr[] = {38, 27, 43, 3, 9, 82, 10};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    mergeSort(arr, 0, n - 1, MergeMode::InPlace);
+    cout << "Sorted array: ";
+    for (int i = 0; i < n; i++)
+        cout << arr[i] << " ";
+    cout << endl << "Expected: 3 9 10 27 38 43 82" << endl << endl;
+
+    // Test Case 2: stability and agreement with the buffered mode
+    cout << "Test Case 2 (stable, matches buffered mode):" << endl;
+    mt19937 rng(3);
+    bool ok = true;
+    for (int t = 0; t < 300; t++) {
+        int size = (t < 50) ? t : 1 + rng() % 20000;
+        int distinct = (t % 2) ? 5 : 1000000;
+        vector<Record> a(size);
+        for (int i = 0; i < size; i++) a[i] = {(int)(rng() % distinct), i};
+        vector<Record> b = a;
+        mergeSort(a.data(), 0, size - 1, MergeMode::InPlace);
+        mergeSort(b.data(), 0, size - 1, MergeMode::Buffered);
+        ok &= stableSorted(a);
+        for (int i = 0; i < size && ok; i++)
+            ok &= a[i].key == b[i].key && a[i].position == b[i].position;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: time and peak extra heap of each mode
+    cout << "Test Case 3 (benchmark, random ints):" << endl;
+    bool inPlaceHeapFree = true;
+    for (int size : {1000000, 4000000}) {
+        vector<int> data(size);
+        for (int& x : data) x = (int)rng();
+
+        for (MergeMode mode : {MergeMode::Buffered, MergeMode::InPlace}) {
+            vector<int> a = data;
+            // Peak is measured above what is already live (data, a), so it is
+            // the sort's own high-water mark, not the running total of requests
+            long long liveBefore = g_alloc.live.load();
+            g_alloc.resetPeak();
+            auto start = chrono::steady_clock::now();
+            mergeSort(a.data(), 0, size - 1, mode);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            long long peak = g_alloc.peak.load() - liveBefore;
+            long long leaked = g_alloc.live.load() - liveBefore;
+
+            cout << "  n=" << size << "  " << (mode == MergeMode::InPlace ? "in-place" : "buffered")
+                 << ": " << ms << " ms, peak extra heap " << peak / 1024 << " KB"
+                 << ", live after " << leaked / 1024 << " KB"
+                 << (is_sorted(a.begin(), a.end()) ? "" : "  NOT SORTED") << endl;
+            if (mode == MergeMode::InPlace)
+                inPlaceHeapFree &= peak == 0 && leaked == 0;
+        }
+    }
+    cout << "In-place mode allocates nothing: " << (inPlaceHeapFree ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    return 0;
+}
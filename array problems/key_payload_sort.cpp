@@ -0,0 +1,294 @@
+/**
+ * Key-Payload Sort (index permutation for wide records)
+ *
+ * Problem: mergeSort moves the elements themselves. With 64-128 byte records
+ * and a 4 or 8 byte key, every level copies whole records through L and R, so
+ * the sort spends its time on memory bandwidth, not on comparisons.
+ *
+ * Approach: Sort small (key, index) pairs, move each record once
+ * - sortPermutation extracts one KeyIndex {key, index} per record (8 or 16
+ *   bytes) and merge sorts those pairs bottom-up, switching between two
+ *   buffers. Ties keep the lower index first, so the order is stable, like
+ *   mergeSort.
+ * - The result is a permutation: perm[i] = index of the record that belongs at
+ *   position i. Pairs carry a 32-bit index while n fits in one, so a pair
+ *   stays 8 bytes for 4-byte keys; larger inputs switch to 64-bit indices
+ * - applyPermutation gathers records into a destination array in blocks of
+ *   APPLY_BLOCK: a first sweep prefetches every source record of the block,
+ *   a second sweep copies them, so the random reads of one block overlap.
+ *   Each record is moved exactly once.
+ * - applyPermutationInPlace follows the permutation's cycles (one temporary
+ *   per cycle, one bit per record) when there is no room for a second array
+ *
+ * Time Complexity: O(n log n) on pairs + O(n) record moves
+ * Space Complexity: O(n) pairs + permutation (+ destination when not in place)
+ */
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+using namespace std;
+
+const int APPLY_BLOCK = 16;  // records prefetched together by applyPermutation
+
+template <typename Key, typename Index>
+struct KeyIndex {
+    Key key;
+    Index index;
+};
+
+// ==================== REFERENCE (mergesort.cpp, templated) ====================
+
+template <typename T, typename Less>
+void merge(T arr[], int left, int mid, int right, Less less) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    vector<T> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (!less(R[j], L[i]))
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+template <typename T, typename Less>
+void mergeSort(T arr[], int left, int right, Less less) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid, less);
+        mergeSort(arr, mid + 1, right, less);
+
+        merge(arr, left, mid, right, less);
+    }
+}
+
+// ==================== PERMUTATION SORT ====================
+
+/**
+ * Stable merge of src[lo, mid) and src[mid, hi) into dst[lo, hi)
+ */
+template <typename Pair>
+void mergePairs(const Pair* src, Pair* dst, size_t lo, size_t mid, size_t hi) {
+    size_t i = lo, j = mid, k = lo;
+
+    while (i < mid && j < hi) {
+        if (!(src[j].key < src[i].key))
+            dst[k++] = src[i++];
+        else
+            dst[k++] = src[j++];
+    }
+
+    while (i < mid)
+        dst[k++] = src[i++];
+
+    while (j < hi)
+        dst[k++] = src[j++];
+}
+
+/**
+ * sortPermutation with Index-wide pair indices (n must fit in Index)
+ */
+template <typename Index, typename Record, typename KeyOf>
+vector<size_t> sortPermutationWith(const Record recs[], size_t n, KeyOf key) {
+    using Key = decltype(key(recs[0]));
+    static_assert(sizeof(Key) <= 8, "keys are expected to be 4 or 8 bytes");
+    using Pair = KeyIndex<Key, Index>;
+
+    vector<Pair> a(n), b(n);
+    for (size_t i = 0; i < n; i++)
+        a[i] = {key(recs[i]), (Index)i};
+
+    // Bottom-up passes, alternating the source and destination buffers
+    Pair* src = a.data();
+    Pair* dst = b.data();
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = min(lo + width, n), hi = min(lo + 2 * width, n);
+            mergePairs(src, dst, lo, mid, hi);
+        }
+        swap(src, dst);
+    }
+
+    vector<size_t> perm(n);
+    for (size_t i = 0; i < n; i++)
+        perm[i] = src[i].index;
+    return perm;
+}
+
+/**
+ * Stable sort order of recs[0, n) by key(record)
+ * @return: perm with perm[i] = index of the record that belongs at position i
+ */
+template <typename Record, typename KeyOf>
+vector<size_t> sortPermutation(const Record recs[], size_t n, KeyOf key) {
+    if (n <= UINT32_MAX)
+        return sortPermutationWith<uint32_t>(recs, n, key);
+    return sortPermutationWith<uint64_t>(recs, n, key);
+}
+
+// ==================== APPLY PERMUTATION ====================
+
+/**
+ * dst[i] = src[perm[i]]; every record is read once and written once
+ */
+template <typename Record>
+void applyPermutation(const Record src[], Record dst[], const vector<size_t>& perm) {
+    size_t n = perm.size();
+    for (size_t block = 0; block < n; block += APPLY_BLOCK) {
+        size_t end = min(block + APPLY_BLOCK, n);
+
+        // Issue all the random reads of this block before using any of them
+        for (size_t i = block; i < end; i++)
+            for (size_t line = 0; line < sizeof(Record); line += 64)
+                __builtin_prefetch((const char*)&src[perm[i]] + line);
+
+        for (size_t i = block; i < end; i++)
+            dst[i] = src[perm[i]];
+    }
+}
+
+/**
+ * Reorders recs so that recs[i] becomes the old recs[perm[i]], without a
+ * second record array
+ */
+template <typename Record>
+void applyPermutationInPlace(Record recs[], const vector<size_t>& perm) {
+    size_t n = perm.size();
+    vector<bool> done(n, false);
+
+    for (size_t start = 0; start < n; start++) {
+        if (done[start] || perm[start] == start) continue;
+
+        // Walk the cycle: each position pulls in the record it needs
+        Record temp = recs[start];
+        size_t i = start;
+        while (perm[i] != start) {
+            recs[i] = recs[perm[i]];
+            done[i] = true;
+            i = perm[i];
+        }
+        recs[i] = temp;
+        done[i] = true;
+    }
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Wide records: an 8-byte key plus payload (96 bytes) or a 4-byte key (64 bytes)
+struct Trade {
+    uint64_t timestamp;
+    uint32_t sequence;
+    char payload[84];
+};
+
+struct Order {
+    int price;
+    uint32_t sequence;
+    char payload[56];
+};
+
+template <typename Record, typename KeyOf>
+void benchmark(const char* name, int n, KeyOf key, mt19937_64& rng) {
+    vector<Record> data(n);
+    for (int i = 0; i < n; i++) {
+        memset(&data[i], 0, sizeof(Record));
+        data[i].sequence = i;
+    }
+    for (Record& r : data) {
+        if constexpr (sizeof(key(r)) == 8)
+            r.timestamp = rng() % (n / 2);
+        else
+            r.price = (int)(rng() % (n / 2)) - n / 4;
+    }
+
+    auto less = [&](const Record& x, const Record& y) { return key(x) < key(y); };
+
+    vector<Record> direct = data;
+    auto start = chrono::steady_clock::now();
+    mergeSort(direct.data(), 0, n - 1, less);
+    double directMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    vector<Record> gathered(n);
+    start = chrono::steady_clock::now();
+    vector<size_t> perm = sortPermutation(data.data(), n, key);
+    double sortMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    applyPermutation(data.data(), gathered.data(), perm);
+    double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    vector<Record> inPlace = data;
+    start = chrono::steady_clock::now();
+    applyPermutationInPlace(inPlace.data(), perm);
+    double inPlaceMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // Stable sorts agree exactly, so the sequence numbers must match too
+    bool same = true;
+    for (int i = 0; i < n; i++)
+        same &= direct[i].sequence == gathered[i].sequence && gathered[i].sequence == inPlace[i].sequence;
+
+    cout << "  " << name << " (" << sizeof(Record) << " B records, n=" << n << "): "
+         << (same ? "PASSED ✓" : "FAILED ✗") << endl;
+    cout << "    mergeSort on records: " << directMs << " ms" << endl;
+    cout << "    permutation sort: " << sortMs << " ms, + apply: " << totalMs << " ms"
+         << "   in-place apply alone: " << inPlaceMs << " ms" << endl;
+}
+
+int main() {
+    // Test Case 1: the original example, as records with a payload
+    cout << "Test Case 1:" << endl;
+    int keys[] = {38, 27, 43, 3, 9, 82, 10};
+    int n = sizeof(keys) / sizeof(keys[0]);
+    vector<Order> orders(n);
+    for (int i = 0; i < n; i++) orders[i] = {keys[i], (uint32_t)i, {}};
+    vector<size_t> perm = sortPermutation(orders.data(), n, [](const Order& o) { return o.price; });
+    applyPermutationInPlace(orders.data(), perm);
+    cout << "Permutation: ";
+    for (size_t p : perm) cout << p << " ";
+    cout << endl << "Sorted prices: ";
+    for (const Order& o : orders) cout << o.price << " ";
+    cout << endl << "Expected: 3 4 6 1 0 2 5 / 3 9 10 27 38 43 82" << endl << endl;
+
+    // Test Case 2: stability on duplicate-heavy keys, both apply variants
+    cout << "Test Case 2 (stable, both apply modes vs mergeSort):" << endl;
+    mt19937_64 rng(36);
+    bool ok = true;
+    for (int t = 0; t < 200; t++) {
+        int size = (t < 20) ? t : 1 + rng() % 5000;
+        vector<Order> a(size);
+        for (int i = 0; i < size; i++) a[i] = {(int)(rng() % (t % 2 ? 4 : 100000)), (uint32_t)i, {}};
+        auto price = [](const Order& o) { return o.price; };
+
+        vector<Order> expected = a;
+        if (size) mergeSort(expected.data(), 0, size - 1, [](const Order& x, const Order& y) { return x.price < y.price; });
+
+        vector<size_t> p = sortPermutation(a.data(), size, price);
+        vector<Order> gathered(size);
+        applyPermutation(a.data(), gathered.data(), p);
+        applyPermutationInPlace(a.data(), p);
+        for (int i = 0; i < size; i++)
+            ok &= expected[i].sequence == gathered[i].sequence && expected[i].sequence == a[i].sequence;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: timing, moving wide records once vs at every merge level
+    cout << "Test Case 3 (timing):" << endl;
+    benchmark<Trade>("8-byte key", 1 << 20, [](const Trade& r) { return r.timestamp; }, rng);
+    benchmark<Order>("4-byte key", 1 << 20, [](const Order& r) { return r.price; }, rng);
+
+    return 0;
+}
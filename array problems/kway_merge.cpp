@@ -0,0 +1,291 @@
+/**
+ * K-Way Merge of Pre-Sorted Shards (loser tree)
+ *
+ * Problem: Ingest produces many shards that are already sorted. Concatenating
+ * them and running mergeSort again repeats O(N log N) work that the shards
+ * already did. Merging them pairwise with merge() still makes log2(k) passes
+ * over all the data.
+ *
+ * Approach: Tournament (loser) tree over k input spans, one streaming pass
+ * - Leaves are the current heads of the k shards; every internal node keeps
+ *   the loser of the match played there, and the overall winner sits on top
+ * - Emitting the winner and advancing its shard replays only the matches on
+ *   one leaf-to-root path: log2(k) comparisons per output element, every
+ *   input element read once, the output written sequentially
+ * - Ties go to the lower shard index, so the result equals a stable sort of
+ *   the shards concatenated in order (the same guarantee as mergeSort)
+ * - k == 1 is a copy and k == 2 uses the two-way merge loop from merge()
+ * - Parallel mode: sample splitter keys, cut every shard at the same
+ *   splitters with a lower-bound search, and let each thread merge its own
+ *   key range into its own slice of the output. Equal keys always fall into
+ *   the same range, so stability holds across threads.
+ *
+ * Time Complexity: O(N log k) for N total elements
+ * Space Complexity: O(k) tree + output
+ *
+ * Usage: ./kway_merge [shards] [shardSize]   (default 256 shards of 20000)
+ * Build: g++ -std=c++17 -O2 -pthread kway_merge.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// A sorted shard (read-only view)
+struct Span {
+    const int* data;
+    size_t size;
+};
+
+// ==================== TWO-WAY MERGE (merge() loop from mergesort.cpp) ====================
+
+void mergeTwo(const Span& L, const Span& R, int* out) {
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < L.size && j < R.size) {
+        if (L.data[i] <= R.data[j])
+            out[k++] = L.data[i++];
+        else
+            out[k++] = R.data[j++];
+    }
+
+    while (i < L.size)
+        out[k++] = L.data[i++];
+
+    while (j < R.size)
+        out[k++] = R.data[j++];
+}
+
+// ==================== LOSER TREE ====================
+
+class LoserTree {
+public:
+    explicit LoserTree(const vector<Span>& spans) : k(spans.size()) {
+        leaves = 1;
+        while (leaves < k) leaves *= 2;
+        cur.assign(leaves, nullptr);
+        end.assign(leaves, nullptr);
+        for (int s = 0; s < k; s++) {
+            cur[s] = spans[s].data;
+            end[s] = spans[s].data + spans[s].size;
+        }
+
+        // Build bottom-up: play every match once, storing losers
+        vector<uint64_t> winner(2 * leaves);
+        for (int s = 0; s < leaves; s++)
+            winner[leaves + s] = headOf(s);
+        tree.assign(leaves, EXHAUSTED);
+        for (int node = leaves - 1; node >= 1; node--) {
+            winner[node] = min(winner[2 * node], winner[2 * node + 1]);
+            tree[node] = max(winner[2 * node], winner[2 * node + 1]);
+        }
+        tree[0] = winner[1];
+    }
+
+    /**
+     * Writes the next smallest element to *out; false when all shards are exhausted
+     */
+    bool next(int* out) {
+        uint64_t top = tree[0];
+        if (top == EXHAUSTED) return false;
+
+        int s = (int)(uint32_t)top;
+        *out = (int)((uint32_t)(top >> 32) ^ 0x80000000u);
+        cur[s]++;
+
+        // Replay matches from s's leaf to the root. Losers are stored as packed
+        // heads, so every match is one min / max pair with no branch and no
+        // extra memory lookup
+        uint64_t winnerNow = headOf(s);
+        for (int node = (leaves + s) / 2; node >= 1; node /= 2) {
+            uint64_t other = tree[node];
+            tree[node] = max(other, winnerNow);
+            winnerNow = min(other, winnerNow);
+        }
+        tree[0] = winnerNow;
+        return true;
+    }
+
+private:
+    static constexpr uint64_t EXHAUSTED = UINT64_MAX;
+
+    int k;
+    int leaves;
+    vector<const int*> cur, end;  // read cursor / end per shard
+    vector<uint64_t> tree;        // tree[0] = winner, tree[1..leaves) = losers
+
+    // Pack (key, shard) so one unsigned compare orders by key, then by shard
+    // index (ties go to the lower shard: stability); exhausted shards sort last
+    uint64_t headOf(int s) const {
+        if (cur[s] == end[s]) return EXHAUSTED;
+        uint32_t key = (uint32_t)*cur[s] ^ 0x80000000u;
+        return ((uint64_t)key << 32) | (uint32_t)s;
+    }
+};
+
+// ==================== K-WAY MERGE API ====================
+
+size_t totalSize(const vector<Span>& spans) {
+    size_t total = 0;
+    for (const Span& s : spans) total += s.size;
+    return total;
+}
+
+/**
+ * Merges all sorted spans into out (must hold totalSize(spans) elements)
+ */
+void kWayMerge(const vector<Span>& spans, int* out) {
+    if (spans.empty()) return;
+    if (spans.size() == 1) {
+        copy(spans[0].data, spans[0].data + spans[0].size, out);
+        return;
+    }
+    if (spans.size() == 2) {
+        mergeTwo(spans[0], spans[1], out);
+        return;
+    }
+
+    LoserTree tree(spans);
+    while (tree.next(out))
+        out++;
+}
+
+/**
+ * Parallel k-way merge: the key space is cut at threads - 1 splitters,
+ * sampled from the shards, and each key range is merged by its own thread
+ */
+void kWayMergeParallel(const vector<Span>& spans, int* out, unsigned threads) {
+    size_t total = totalSize(spans);
+    if (threads <= 1 || total < (1 << 16)) {
+        kWayMerge(spans, out);
+        return;
+    }
+
+    // Regular samples from every shard, sorted, then evenly spaced splitters
+    vector<int> samples;
+    const size_t perShard = 64;
+    for (const Span& s : spans)
+        for (size_t i = 1; i <= perShard && s.size; i++)
+            samples.push_back(s.data[(s.size * i) / (perShard + 1)]);
+    sort(samples.begin(), samples.end());
+
+    vector<int> splitters;
+    for (unsigned p = 1; p < threads; p++)
+        splitters.push_back(samples[samples.size() * p / threads]);
+
+    // cut[p][s] = first position in shard s of key range p (lower bound of splitter)
+    size_t k = spans.size();
+    vector<vector<size_t>> cut(threads + 1, vector<size_t>(k));
+    for (size_t s = 0; s < k; s++) {
+        cut[0][s] = 0;
+        cut[threads][s] = spans[s].size;
+        for (unsigned p = 1; p < threads; p++)
+            cut[p][s] = lower_bound(spans[s].data, spans[s].data + spans[s].size, splitters[p - 1]) - spans[s].data;
+    }
+
+    vector<thread> workers;
+    size_t offset = 0;
+    for (unsigned p = 0; p < threads; p++) {
+        vector<Span> part(k);
+        size_t partSize = 0;
+        for (size_t s = 0; s < k; s++) {
+            part[s] = {spans[s].data + cut[p][s], cut[p + 1][s] - cut[p][s]};
+            partSize += part[s].size;
+        }
+        workers.emplace_back([part, out, offset]() { kWayMerge(part, out + offset); });
+        offset += partSize;
+    }
+    for (auto& w : workers) w.join();
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Reference: concatenate in shard order, stable sort
+vector<int> concatAndSort(const vector<vector<int>>& shards) {
+    vector<int> all;
+    for (const auto& s : shards) all.insert(all.end(), s.begin(), s.end());
+    stable_sort(all.begin(), all.end());
+    return all;
+}
+
+vector<Span> spansOf(const vector<vector<int>>& shards) {
+    vector<Span> spans;
+    for (const auto& s : shards) spans.push_back({s.data(), s.size()});
+    return spans;
+}
+
+int main(int argc, char* argv[]) {
+    int shardCount = (argc > 1) ? atoi(argv[1]) : 256;
+    int shardSize = (argc > 2) ? atoi(argv[2]) : 20000;
+    mt19937 rng(17);
+
+    // Test Case 1: three small shards
+    cout << "Test Case 1:" << endl;
+    vector<vector<int>> small = {{1, 4, 9}, {2, 3, 10, 11}, {0, 4, 5}};
+    vector<int> out(10);
+    kWayMerge(spansOf(small), out.data());
+    cout << "Merged: ";
+    for (int x : out) cout << x << " ";
+    cout << endl << "Expected: 0 1 2 3 4 4 5 9 10 11" << endl << endl;
+
+    // Test Case 2: random shard counts / sizes, including empty shards and duplicates
+    cout << "Test Case 2 (serial and parallel vs concatenate + sort):" << endl;
+    bool ok = true;
+    for (int t = 0; t < 100; t++) {
+        int k = 1 + rng() % 40;
+        vector<vector<int>> shards(k);
+        for (auto& s : shards) {
+            s.resize(rng() % 3000);
+            for (int& x : s) x = rng() % (t % 2 ? 20 : 1000000);
+            sort(s.begin(), s.end());
+        }
+        vector<int> expected = concatAndSort(shards);
+        vector<int> serial(expected.size()), parallel(expected.size());
+        kWayMerge(spansOf(shards), serial.data());
+        kWayMergeParallel(spansOf(shards), parallel.data(), 4);
+        ok &= serial == expected && parallel == expected;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: many large shards
+    cout << "Test Case 3 (" << shardCount << " shards x " << shardSize << " elements):" << endl;
+    vector<vector<int>> shards(shardCount, vector<int>(shardSize));
+    for (auto& s : shards) {
+        for (int& x : s) x = (int)rng();
+        sort(s.begin(), s.end());
+    }
+    size_t total = (size_t)shardCount * shardSize;
+    vector<int> merged(total);
+
+    auto start = chrono::steady_clock::now();
+    vector<int> all;
+    all.reserve(total);
+    for (const auto& s : shards) all.insert(all.end(), s.begin(), s.end());
+    stable_sort(all.begin(), all.end());
+    double resortMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    kWayMerge(spansOf(shards), merged.data());
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    bool same = merged == all;
+
+    unsigned threads = max(2u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    kWayMergeParallel(spansOf(shards), merged.data(), threads);
+    double parallelMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    same &= merged == all;
+
+    cout << "  concatenate + sort: " << resortMs << " ms" << endl;
+    cout << "  loser tree: " << serialMs << " ms" << endl;
+    cout << "  loser tree, " << threads << " threads: " << parallelMs << " ms" << endl;
+    cout << "  results match: " << (same ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+/**
+ * Learned Index for Sorted Arrays (two-level piecewise-linear model)
+ *
+ * Problem: binarySearch always halves the range, about 24 probes for 16M keys,
+ * and nearly every probe is a cache miss. Keys such as timestamps are close to
+ * uniformly distributed, so a linear model of key -> position predicts the
+ * position almost exactly.
+ *
+ * Approach: Recursive model index (RMI), built once over the sorted array
+ * - Root model: linear interpolation over [minKey, maxKey] routes a key to one
+ *   of L leaf models. Routing is monotone, so each leaf owns a contiguous
+ *   position range [start, end)
+ * - Leaf model: a line through the first and last key of its range, plus the
+ *   largest prediction error measured over every key in the range
+ * - Lookup: predict, then run a branchless lower-bound search inside the
+ *   window [prediction - error, prediction + error + 1]. Because the model is
+ *   monotone, the window also brackets the lower bound of keys that are absent.
+ * - Fallback: a leaf whose error exceeds MAX_LEAF_ERROR (clustered or
+ *   pathological keys) is flagged and searched with plain binarySearch over its
+ *   range, so the worst case stays O(log n)
+ *
+ * Result contract matches binarySearch: the index of a matching element, or -1.
+ *
+ * Time Complexity: build O(n); lookup O(1) model evaluation + O(log error)
+ * Space Complexity: O(L) leaf models (L = n / 256 by default)
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+const int KEYS_PER_LEAF = 256;   // average leaf size
+const int MAX_LEAF_ERROR = 64;   // beyond this, a leaf falls back to binarySearch
+
+// ==================== REFERENCE (original binary_search.cpp) ====================
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// ==================== LEARNED INDEX ====================
+
+/**
+ * First index in [lo, hi) with arr[index] >= target (hi if none), branchless
+ */
+int lowerBoundBranchless(const int arr[], int lo, int hi, int target) {
+    int len = hi - lo;
+    const int* base = arr + lo;
+    while (len > 1) {
+        int half = len / 2;
+        base = (base[half - 1] < target) ? base + half : base;
+        len -= half;
+    }
+    int idx = base - arr;
+    return (len == 1 && *base < target) ? idx + 1 : idx;
+}
+
+class LearnedIndex {
+public:
+    /**
+     * Builds the index over sorted arr[0, n). The array is not copied and
+     * must stay alive and unchanged while the index is used.
+     */
+    LearnedIndex(int arr[], int n) : arr(arr), n(n) {
+        int leafCount = max(1, n / KEYS_PER_LEAF);
+        leaves.resize(leafCount);
+        if (n == 0) return;
+
+        minKey = arr[0];
+        double range = (double)arr[n - 1] - minKey + 1;
+        rootSlope = leafCount / range;
+
+        // Route every key; leaves own contiguous ranges because routing is monotone
+        int pos = 0;
+        for (int l = 0; l < leafCount; l++) {
+            Leaf& leaf = leaves[l];
+            leaf.start = pos;
+            while (pos < n && route(arr[pos]) == l)
+                pos++;
+            leaf.end = pos;
+            train(leaf);
+        }
+    }
+
+    /**
+     * @return: index of target in the array, or -1 (same contract as binarySearch)
+     */
+    int search(int target) const {
+        if (n == 0) return -1;
+        const Leaf& leaf = leaves[route(target)];
+
+        if (leaf.fallback) {
+            int idx = binarySearch(arr + leaf.start, leaf.end - leaf.start, target);
+            return idx < 0 ? -1 : leaf.start + idx;
+        }
+
+        int p = predict(leaf, target);
+        int lo = max(leaf.start, p - leaf.error);
+        int hi = min(leaf.end, p + leaf.error + 1);
+        int idx = lowerBoundBranchless(arr, lo, hi, target);
+        return (idx < leaf.end && arr[idx] == target) ? idx : -1;
+    }
+
+    // Diagnostics: mean window of model-searched keys, fraction of keys in fallback leaves
+    double meanWindow() const {
+        double sum = 0;
+        long long keys = 0;
+        for (const Leaf& l : leaves) {
+            if (l.fallback) continue;
+            sum += (double)(l.end - l.start) * (2 * l.error + 1);
+            keys += l.end - l.start;
+        }
+        return keys ? sum / keys : 0;
+    }
+
+    double fallbackFraction() const {
+        long long keys = 0;
+        for (const Leaf& l : leaves)
+            if (l.fallback) keys += l.end - l.start;
+        return n ? (double)keys / n : 0;
+    }
+
+private:
+    struct Leaf {
+        int start = 0, end = 0;   // owned positions [start, end)
+        int firstKey = 0;
+        double slope = 0;
+        int error = 0;            // max |prediction - position| over the range
+        bool fallback = false;
+    };
+
+    int* arr;
+    int n;
+    int minKey = 0;
+    double rootSlope = 0;
+    vector<Leaf> leaves;
+
+    int route(int key) const {
+        double l = ((double)key - minKey) * rootSlope;
+        if (l < 0) return 0;
+        return min((long long)l, (long long)leaves.size() - 1);
+    }
+
+    // Linear prediction clamped to the leaf's own range (clamping keeps it monotone)
+    int predict(const Leaf& leaf, int key) const {
+        double p = leaf.start + ((double)key - leaf.firstKey) * leaf.slope;
+        p = min(max(p, (double)leaf.start), (double)max(leaf.start, leaf.end - 1));
+        return (int)p;
+    }
+
+    void train(Leaf& leaf) {
+        int count = leaf.end - leaf.start;
+        if (count == 0) return;
+
+        leaf.firstKey = arr[leaf.start];
+        double span = (double)arr[leaf.end - 1] - leaf.firstKey;
+        leaf.slope = span > 0 ? (count - 1) / span : 0;
+
+        int maxErr = 0;
+        for (int i = leaf.start; i < leaf.end; i++)
+            maxErr = max(maxErr, abs(predict(leaf, arr[i]) - i));
+        // +1 covers truncation of the prediction for keys between two samples
+        leaf.error = maxErr + 1;
+        leaf.fallback = leaf.error > MAX_LEAF_ERROR;
+    }
+};
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+vector<int> makeKeys(const string& shape, int n, mt19937_64& rng) {
+    vector<int> keys(n);
+    if (shape == "uniform timestamps") {
+        long long t = 1600000000;
+        for (int& k : keys) k = (int)((t += 1 + rng() % 60) & 0x7fffffff);
+    } else if (shape == "exponential") {
+        exponential_distribution<double> d(1e-6);
+        for (int& k : keys) k = (int)min(2e9, d(rng));
+    } else if (shape == "duplicates") {
+        for (int& k : keys) k = rng() % 1000;
+    } else {  // "clustered": almost everything in one tiny range plus outliers
+        for (int& k : keys) k = (rng() % 100 == 0) ? (int)(rng() % 2000000000) : (int)(rng() % 5000);
+    }
+    sort(keys.begin(), keys.end());
+    return keys;
+}
+
+int main() {
+    // Test Case 1: the original example
+    cout << "Test Case 1:" << endl;
+    int arr[] = {2, 4, 6, 8, 10, 12};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    LearnedIndex small(arr, n);
+    cout << "search(10) = " << small.search(10) << ", search(7) = " << small.search(7) << endl;
+    cout << "Expected: 4, -1" << endl << endl;
+
+    // Test Case 2: agreement with binarySearch on every distribution
+    cout << "Test Case 2 (vs binarySearch on each distribution):" << endl;
+    mt19937_64 rng(5);
+    for (string shape : {"uniform timestamps", "exponential", "duplicates", "clustered"}) {
+        vector<int> keys = makeKeys(shape, 200000, rng);
+        LearnedIndex index(keys.data(), keys.size());
+        bool ok = true;
+        for (int q = 0; q < 200000; q++) {
+            int target = (q % 2) ? keys[rng() % keys.size()] + (int)(rng() % 3) - 1 : (int)rng();
+            int expected = binarySearch(keys.data(), keys.size(), target);
+            int got = index.search(target);
+            ok &= (expected == -1) == (got == -1);
+            ok &= got == -1 || keys[got] == target;
+        }
+        cout << "  " << shape << ": " << (ok ? "PASSED ✓" : "FAILED ✗")
+             << "  mean window=" << index.meanWindow()
+             << "  fallback keys=" << index.fallbackFraction() * 100 << "%" << endl;
+    }
+    cout << endl;
+
+    // Test Case 3: timing on 2^24 near-uniform timestamps
+    cout << "Test Case 3 (timing, 2^24 timestamps, 4 * 10^6 lookups):" << endl;
+    vector<int> keys = makeKeys("uniform timestamps", 1 << 24, rng);
+    vector<int> queries(4000000);
+    for (int& q : queries) q = keys[rng() % keys.size()];
+
+    auto start = chrono::steady_clock::now();
+    LearnedIndex index(keys.data(), keys.size());
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    long long sumA = 0, sumB = 0;
+    start = chrono::steady_clock::now();
+    for (int q : queries) sumA += binarySearch(keys.data(), keys.size(), q);
+    double binMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int q : queries) sumB += index.search(q);
+    double learnedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "  build: " << buildMs << " ms" << endl;
+    cout << "  binarySearch: " << binMs << " ms   learned index: " << learnedMs << " ms"
+         << (sumA == sumB ? "" : "  (different indices among duplicates)") << endl;
+
+    return 0;
+}
@@ -0,0 +1,284 @@
+/**
+ * Top-K Selection and Partial Merge Sort
+ *
+ * Problem: Many callers sort the whole array with mergeSort and then read only
+ * the first k elements, paying O(n log n) for an answer that needs O(n + k log k).
+ *
+ * Approach: Select first, sort only what is needed
+ * - introSelect (nth_element): quickselect with median-of-three pivots and a
+ *   three-way partition, which handles duplicate-heavy inputs. If the
+ *   recursion depth exceeds 2 log2 n, it switches to median-of-medians
+ *   pivots, so the worst case stays O(n) even on adversarial input
+ * - partialMergeSort: introSelect puts the k smallest elements in the first k
+ *   positions, then mergeSort sorts only that prefix. Positions k..n-1 hold
+ *   the remaining elements in unspecified order.
+ * - topK (heap-based): a size-k max-heap over one pass of the input. It never
+ *   modifies the input, which suits streams and read-only arrays when k << n.
+ *
+ * Selection is not stable: equal keys may swap. For plain ints the first k
+ * positions are identical to mergeSort's.
+ *
+ * Time Complexity: introSelect O(n); partialMergeSort O(n + k log k);
+ *                  topK O(n log k)
+ * Space Complexity: O(log n) stack for selection, O(k) for the prefix sort / heap
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+// ==================== MERGE SORT (for the selected prefix) ====================
+
+template <typename T>
+void merge(T arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    vector<T> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (!(R[j] < L[i]))
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+template <typename T>
+void mergeSort(T arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+// ==================== INTROSELECT ====================
+
+template <typename T>
+void insertionSort(T arr[], int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        T key = arr[i];
+        int j = i - 1;
+        while (j >= left && key < arr[j]) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * Three-way partition of arr[left..right] around pivot:
+ * [left, lt) < pivot, [lt, gt] == pivot, (gt, right] > pivot
+ */
+template <typename T>
+pair<int, int> partition3(T arr[], int left, int right, T pivot) {
+    int lt = left, i = left, gt = right;
+    while (i <= gt) {
+        if (arr[i] < pivot)
+            swap(arr[lt++], arr[i++]);
+        else if (pivot < arr[i])
+            swap(arr[i], arr[gt--]);
+        else
+            i++;
+    }
+    return {lt, gt};
+}
+
+template <typename T>
+T medianOfThree(T a, T b, T c) {
+    if (b < a) swap(a, b);
+    if (c < b) swap(b, c);
+    if (b < a) swap(a, b);
+    return b;
+}
+
+template <typename T>
+void introSelectRange(T arr[], int left, int right, int nth, int depthLimit);
+
+/**
+ * Median-of-medians pivot: medians of groups of 5, then their median
+ * (found recursively with introSelect); guarantees a 30/70 split
+ */
+template <typename T>
+T medianOfMedians(T arr[], int left, int right) {
+    int count = 0;
+    for (int g = left; g <= right; g += 5) {
+        int gRight = min(g + 4, right);
+        insertionSort(arr, g, gRight);
+        swap(arr[left + count], arr[g + (gRight - g) / 2]);
+        count++;
+    }
+    int mid = left + (count - 1) / 2;
+    introSelectRange(arr, left, left + count - 1, mid, 0);
+    return arr[mid];
+}
+
+/**
+ * Rearranges arr[left..right] so arr[nth] is the element a full sort would
+ * put there, with nothing greater before it and nothing smaller after it.
+ * depthLimit = 0 forces median-of-medians pivots.
+ */
+template <typename T>
+void introSelectRange(T arr[], int left, int right, int nth, int depthLimit) {
+    while (right - left > 16) {
+        T pivot;
+        if (depthLimit > 0) {
+            depthLimit--;
+            pivot = medianOfThree(arr[left], arr[left + (right - left) / 2], arr[right]);
+        } else {
+            pivot = medianOfMedians(arr, left, right);
+        }
+
+        pair<int, int> eq = partition3(arr, left, right, pivot);
+        if (nth < eq.first)
+            right = eq.first - 1;
+        else if (nth > eq.second)
+            left = eq.second + 1;
+        else
+            return;  // nth lies in the run of elements equal to the pivot
+    }
+    insertionSort(arr, left, right);
+}
+
+template <typename T>
+void introSelect(T arr[], int n, int nth) {
+    if (n <= 1 || nth < 0 || nth >= n) return;
+    int depthLimit = 2;
+    for (int m = n; m > 1; m /= 2) depthLimit += 2;
+    introSelectRange(arr, 0, n - 1, nth, depthLimit);
+}
+
+// ==================== PARTIAL SORT / TOP-K ====================
+
+/**
+ * Finalizes arr[0..k-1] as the k smallest elements in sorted order
+ */
+template <typename T>
+void partialMergeSort(T arr[], int n, int k) {
+    k = min(k, n);
+    if (k <= 0) return;
+    if (k < n)
+        introSelect(arr, n, k - 1);
+    mergeSort(arr, 0, k - 1);
+}
+
+/**
+ * The k smallest elements in sorted order, without modifying arr
+ */
+template <typename T>
+vector<T> topK(const T arr[], int n, int k) {
+    k = min(k, n);
+    if (k <= 0) return {};
+
+    priority_queue<T> heap(arr, arr + k);  // max-heap of the best k so far
+    for (int i = k; i < n; i++) {
+        if (arr[i] < heap.top()) {
+            heap.pop();
+            heap.push(arr[i]);
+        }
+    }
+
+    vector<T> result(k);
+    for (int i = k - 1; i >= 0; i--) {
+        result[i] = heap.top();
+        heap.pop();
+    }
+    return result;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main() {
+    // Test Case 1: the original example, first 3 positions only
+    cout << "Test Case 1:" << endl;
+    int arr[] = {38, 27, 43, 3, 9, 82, 10};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    partialMergeSort(arr, n, 3);
+    cout << "First 3: " << arr[0] << " " << arr[1] << " " << arr[2] << endl;
+    vector<int> top = topK(arr, n, 4);
+    cout << "topK(4): ";
+    for (int x : top) cout << x << " ";
+    cout << endl << "Expected: First 3: 3 9 10, topK(4): 3 9 10 27" << endl << endl;
+
+    // Test Case 2: agreement with a full sort, including duplicates and k edge cases
+    cout << "Test Case 2 (vs full mergeSort):" << endl;
+    mt19937 rng(8);
+    bool ok = true;
+    for (int t = 0; t < 400; t++) {
+        int size = rng() % 3000;
+        vector<int> a(size);
+        for (int& x : a) x = rng() % (t % 3 == 0 ? 3 : 100000);
+        if (t % 5 == 0) sort(a.begin(), a.end());
+        vector<int> full = a;
+        if (size) mergeSort(full.data(), 0, size - 1);
+
+        int k = (t % 4 == 0) ? size : rng() % (size + 1);
+        vector<int> partial = a;
+        partialMergeSort(partial.data(), size, k);
+        ok &= equal(full.begin(), full.begin() + k, partial.begin());
+
+        vector<int> heapTop = topK(a.data(), size, k);
+        ok &= equal(full.begin(), full.begin() + k, heapTop.begin());
+
+        if (size) {
+            int nth = rng() % size;
+            vector<int> sel = a;
+            introSelect(sel.data(), size, nth);
+            ok &= sel[nth] == full[nth];
+            for (int i = 0; i < nth; i++) ok &= !(sel[nth] < sel[i]);
+            for (int i = nth + 1; i < size; i++) ok &= !(sel[i] < sel[nth]);
+        }
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: adversarial (organ pipe) input, which defeats median-of-three
+    cout << "Test Case 3 (organ pipe input, depth limit fallback):" << endl;
+    vector<int> pipe(200000);
+    for (int i = 0; i < (int)pipe.size(); i++) pipe[i] = min(i, (int)pipe.size() - 1 - i);
+    vector<int> sortedPipe = pipe;
+    sort(sortedPipe.begin(), sortedPipe.end());
+    introSelect(pipe.data(), pipe.size(), 150000);
+    cout << (pipe[150000] == sortedPipe[150000] ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: timing, n = 4 * 10^6
+    cout << "Test Case 4 (timing, n = 4 * 10^6):" << endl;
+    vector<int> data(4000000);
+    for (int& x : data) x = (int)rng();
+    {
+        vector<int> a = data;
+        auto start = chrono::steady_clock::now();
+        mergeSort(a.data(), 0, a.size() - 1);
+        cout << "  full mergeSort: " << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+    }
+    for (int k : {10, 1000, 100000}) {
+        vector<int> a = data;
+        auto start = chrono::steady_clock::now();
+        partialMergeSort(a.data(), a.size(), k);
+        double partialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        vector<int> h = topK(data.data(), data.size(), k);
+        double heapMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << "  k=" << k << "  partialMergeSort: " << partialMs << " ms   topK heap: " << heapMs << " ms" << endl;
+    }
+
+    return 0;
+}
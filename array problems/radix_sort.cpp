@@ -0,0 +1,309 @@
+/**
+ * LSD Radix Sort Backend for mergeSort
+ *
+ * Problem: mergeSort is a comparison sort: O(N log N) compares and a branch per
+ * element per level. For plain 32-bit and 64-bit integer keys, a radix sort
+ * does a fixed number of linear passes and leaves far less throughput unused.
+ *
+ * Approach: Least-significant-digit radix sort behind the mergeSort entry point
+ * - mergeSort(arr, left, right) keeps its signature; for 4- and 8-byte integer
+ *   keys with at least RADIX_THRESHOLD elements it dispatches to radixSort,
+ *   otherwise it runs the original top-down merge sort
+ * - Digits are 11 bits by default (3 passes for 32-bit keys, 6 for 64-bit);
+ *   8-bit digits are available through the DigitBits template parameter
+ * - One read pass builds the histograms of every digit at once, prefetching
+ *   ahead of the read cursor; passes where every key has the same digit are
+ *   skipped entirely
+ * - Parallel histogram mode splits the counting pass across threads; each
+ *   thread counts its own chunk and the counts are summed
+ * - Signed keys are handled by flipping the sign bit, so negative numbers
+ *   order before positive ones
+ * - Each scatter pass walks the input in order, so equal keys keep their
+ *   relative order: the sort is stable, the same guarantee mergeSort gives
+ *
+ * Time Complexity: O(P * (N + 2^B)) for P passes of B-bit digits
+ * Space Complexity: O(N) scatter buffer + O(P * 2^B) histograms
+ *
+ * Build: g++ -std=c++17 -O2 -pthread radix_sort.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+using namespace std;
+
+// Below this many elements the comparison sort wins (histogram setup dominates)
+const int RADIX_THRESHOLD = 256;
+
+// Input size below which starting histogram threads costs more than it saves
+const int PARALLEL_HISTOGRAM_MIN = 1 << 20;
+
+// ==================== COMPARISON BACKEND (original mergeSort) ====================
+
+// Same merge as mergesort.cpp, with heap buffers instead of VLAs so large
+// non-integer arrays (which never take the radix path) cannot overflow the stack
+template <typename T>
+void merge(T arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    vector<T> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+template <typename T>
+void mergeSortComparison(T arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSortComparison(arr, left, mid);
+        mergeSortComparison(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+// ==================== RADIX BACKEND ====================
+
+/**
+ * Map a signed or unsigned integer to an unsigned key with the same order
+ */
+template <typename K>
+typename make_unsigned<K>::type radixKey(K value) {
+    typedef typename make_unsigned<K>::type U;
+    U key = (U)value;
+    if (is_signed<K>::value)
+        key ^= (U)1 << (sizeof(K) * 8 - 1);
+    return key;
+}
+
+/**
+ * Count every digit of the keys of arr[begin, end) into hist[pass * radix + digit]
+ */
+template <int DigitBits, typename T, typename KeyFn>
+void countDigits(const T arr[], size_t begin, size_t end, KeyFn key, vector<size_t>& hist) {
+    typedef decltype(key(arr[0])) K;
+    const int radix = 1 << DigitBits;
+    const int passes = (sizeof(K) * 8 + DigitBits - 1) / DigitBits;
+    const size_t mask = radix - 1;
+
+    for (size_t i = begin; i < end; i++) {
+        // Prefetch a few cache lines ahead of the read cursor
+        __builtin_prefetch(arr + i + 64);
+
+        auto k = radixKey(key(arr[i]));
+        for (int p = 0; p < passes; p++)
+            hist[p * radix + ((k >> (p * DigitBits)) & mask)]++;
+    }
+}
+
+/**
+ * Stable LSD radix sort of arr[0, n) by an integer key extracted with key()
+ * @param parallelHistogram: count digits with several threads (large inputs)
+ */
+template <int DigitBits = 11, typename T, typename KeyFn>
+void radixSortBy(T arr[], size_t n, KeyFn key, bool parallelHistogram = false) {
+    typedef decltype(key(arr[0])) K;
+    static_assert(is_integral<K>::value, "radixSort needs integer keys");
+    const int radix = 1 << DigitBits;
+    const int passes = (sizeof(K) * 8 + DigitBits - 1) / DigitBits;
+    const size_t mask = radix - 1;
+    if (n < 2) return;
+
+    // 1. Histograms for all passes in one read of the input
+    vector<size_t> hist(passes * radix, 0);
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    if (parallelHistogram && threads > 1 && n >= (size_t)PARALLEL_HISTOGRAM_MIN) {
+        vector<vector<size_t>> local(threads, vector<size_t>(passes * radix, 0));
+        vector<thread> workers;
+        size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t begin = min(n, t * chunk), end = min(n, begin + chunk);
+            workers.emplace_back([&, t, begin, end]() {
+                countDigits<DigitBits>(arr, begin, end, key, local[t]);
+            });
+        }
+        for (auto& w : workers) w.join();
+        for (auto& h : local)
+            for (size_t i = 0; i < hist.size(); i++)
+                hist[i] += h[i];
+    } else {
+        countDigits<DigitBits>(arr, 0, n, key, hist);
+    }
+
+    // 2. One stable scatter per digit, ping-ponging between arr and buffer
+    vector<T> buffer(n);
+    T* src = arr;
+    T* dst = buffer.data();
+
+    for (int p = 0; p < passes; p++) {
+        size_t* count = &hist[p * radix];
+
+        // All keys share this digit: the pass would not move anything
+        if (count[(radixKey(key(src[0])) >> (p * DigitBits)) & mask] == n)
+            continue;
+
+        // Exclusive prefix sum turns counts into output positions
+        size_t sum = 0;
+        for (int d = 0; d < radix; d++) {
+            size_t c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            size_t digit = (radixKey(key(src[i])) >> (p * DigitBits)) & mask;
+            dst[count[digit]++] = src[i];
+        }
+        swap(src, dst);
+    }
+
+    if (src != arr)
+        copy(src, src + n, arr);
+}
+
+/**
+ * Stable LSD radix sort of plain integer keys
+ */
+template <int DigitBits = 11, typename T>
+void radixSort(T arr[], size_t n, bool parallelHistogram = false) {
+    radixSortBy<DigitBits>(arr, n, [](const T& x) { return x; }, parallelHistogram);
+}
+
+// ==================== ENTRY POINT ====================
+
+/**
+ * Sorts arr[left..right] (inclusive, same as the original mergeSort).
+ * 32-bit and 64-bit integer arrays above RADIX_THRESHOLD go to the radix
+ * backend; everything else uses the comparison merge sort. Both are stable.
+ */
+template <typename T>
+void mergeSort(T arr[], int left, int right) {
+    int n = right - left + 1;
+    if constexpr (is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)) {
+        if (n >= RADIX_THRESHOLD) {
+            radixSort(arr + left, n);
+            return;
+        }
+    }
+    mergeSortComparison(arr, left, right);
+}
+
+// ==================== UTILITY FUNCTIONS FOR TESTING ====================
+
+template <typename T>
+vector<T> randomArray(int n, mt19937_64& rng) {
+    vector<T> a(n);
+    for (T& x : a) x = (T)rng();
+    return a;
+}
+
+template <typename T>
+double timeMs(void (*sortFn)(T*, int, int), vector<T> a) {
+    auto start = chrono::steady_clock::now();
+    sortFn(a.data(), 0, a.size() - 1);
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Stable-sort check: sort (key, original index) pairs by key only and make
+// sure equal keys keep their original (increasing) index order
+bool radixIsStable(int n, mt19937_64& rng) {
+    vector<pair<int, int>> items(n);
+    for (int i = 0; i < n; i++)
+        items[i] = {(int)(rng() % 16) - 8, i};  // many duplicates
+
+    radixSortBy(items.data(), n, [](const pair<int, int>& p) { return p.first; });
+
+    for (int i = 1; i < n; i++) {
+        if (items[i].first < items[i - 1].first) return false;
+        if (items[i].first == items[i - 1].first && items[i].second < items[i - 1].second) return false;
+    }
+    return true;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main() {
+    mt19937_64 rng(2024);
+
+    // Test Case 1: the original example (small, comparison backend)
+    cout << "Test Case 1:" << endl;
+    int arr[] = {38, 27, 43, 3, 9, 82, 10};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    mergeSort(arr, 0, n - 1);
+    cout << "Sorted array: ";
+    for (int i = 0; i < n; i++)
+        cout << arr[i] << " ";
+    cout << endl << "Expected: 3 9 10 27 38 43 82" << endl << endl;
+
+    // Test Case 2: radix backend vs comparison backend, int and long long
+    cout << "Test Case 2 (radix vs comparison, random sizes):" << endl;
+    bool ok = true;
+    for (int t = 0; t < 200; t++) {
+        int size = 1 + rng() % 5000;
+        vector<int> a = randomArray<int>(size, rng), b = a;
+        mergeSort(a.data(), 0, size - 1);
+        mergeSortComparison(b.data(), 0, size - 1);
+        ok &= a == b;
+
+        vector<long long> c = randomArray<long long>(size, rng), d = c;
+        mergeSort(c.data(), 0, size - 1);
+        mergeSortComparison(d.data(), 0, size - 1);
+        ok &= c == d;
+
+        // Non-integer keys always take the comparison path
+        vector<double> x(size), y;
+        for (double& v : x) v = (double)(rng() % 1000) / 7;
+        y = x;
+        mergeSort(x.data(), 0, size - 1);
+        stable_sort(y.begin(), y.end());
+        ok &= x == y;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: 8-bit digits, parallel histograms, negative and equal keys
+    cout << "Test Case 3 (8-bit digits, parallel histogram, edge keys):" << endl;
+    vector<int> e = randomArray<int>(1 << 21, rng);
+    e[0] = INT32_MIN; e[1] = INT32_MAX; e[2] = 0; e[3] = -1;
+    vector<int> f = e, g = e;
+    radixSort<8>(f.data(), f.size());
+    radixSort(g.data(), g.size(), true);
+    sort(e.begin(), e.end());
+    vector<int> same(1000, 42), sameSorted = same;
+    radixSort(same.data(), same.size());
+    cout << ((e == f && e == g && same == sameSorted) ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: stability
+    cout << "Test Case 4 (stable order of equal keys):" << endl;
+    cout << (radixIsStable(100000, rng) ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: throughput
+    cout << "Test Case 5 (timing, 10^6 random keys):" << endl;
+    vector<int> i32 = randomArray<int>(1000000, rng);
+    vector<long long> i64 = randomArray<long long>(1000000, rng);
+    cout << "  int32  comparison: " << timeMs<int>(mergeSortComparison<int>, i32) << " ms"
+         << "   radix: " << timeMs<int>(mergeSort<int>, i32) << " ms" << endl;
+    cout << "  int64  comparison: " << timeMs<long long>(mergeSortComparison<long long>, i64) << " ms"
+         << "   radix: " << timeMs<long long>(mergeSort<long long>, i64) << " ms" << endl;
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * Bound, Range and Count Queries on Sorted Arrays
+ *
+ * Problem: binarySearch returns the index of an arbitrary match or -1. With
+ * duplicates, callers also need the first / last occurrence, the number of
+ * elements in a value range [lo, hi], and the k-th element >= x. Emulating those
+ * with linear scans around the match costs O(number of duplicates).
+ *
+ * Approach: One branchless kernel, several thin wrappers
+ * - boundKernel(arr, n, goRight) finds the first index whose element does NOT
+ *   satisfy goRight. The loop always runs ceil(log2 n) boundSteps, and the
+ *   "step right or stay" choice is a conditional move, not a branch.
+ *   - lower_bound:  goRight = (v <  x)
+ *   - upper_bound:  goRight = (v <= x)
+ * - equal_range, first/last occurrence, range_count and kth_at_least are
+ *   built from those two bounds: O(log n) no matter how many duplicates
+ * - Batch range-count runs the same boundStep for BATCH_LANES queries in
+ *   lockstep. The probes of different queries are independent, so their cache
+ *   misses overlap. Before each step, every lane prefetches both places its
+ *   next probe can be (left half or right half), so the next load is in
+ *   flight while the current comparison resolves.
+ *
+ * Time Complexity: O(log n) per query
+ * Space Complexity: O(1) (O(m) output for batches)
+ */
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+const int BATCH_LANES = 8;  // queries searched in lockstep by the batch API
+
+// ==================== KERNEL ====================
+
+/**
+ * One step over a window of len elements starting at base: move right by
+ * half = len / 2 if goRight holds for base[half - 1]. The window shrinks to
+ * len - half either way
+ */
+template <typename GoRight>
+inline const int* boundStep(const int* base, int half, GoRight goRight) {
+    return goRight(base[half - 1]) ? base + half : base;
+}
+
+// Answer once the window is a single element
+template <typename GoRight>
+inline int boundFinish(const int arr[], const int* base, GoRight goRight) {
+    return (base - arr) + (goRight(*base) ? 1 : 0);
+}
+
+/**
+ * First index i in [0, n] such that goRight(arr[i]) is false, assuming goRight
+ * is true for a prefix of the array and false for the rest
+ */
+template <typename GoRight>
+int boundKernel(const int arr[], int n, GoRight goRight) {
+    if (n <= 0) return 0;
+    const int* base = arr;
+    int len = n;
+    while (len > 1) {
+        int half = len / 2;
+        base = boundStep(base, half, goRight);
+        len -= half;
+    }
+    return boundFinish(arr, base, goRight);
+}
+
+// ==================== SEARCH API ====================
+
+// First index with arr[i] >= x (n if none)
+int lowerBound(const int arr[], int n, int x) {
+    return boundKernel(arr, n, [x](int v) { return v < x; });
+}
+
+// First index with arr[i] > x (n if none)
+int upperBound(const int arr[], int n, int x) {
+    return boundKernel(arr, n, [x](int v) { return v <= x; });
+}
+
+// [first, last) index range of elements equal to x
+pair<int, int> equalRange(const int arr[], int n, int x) {
+    return {lowerBound(arr, n, x), upperBound(arr, n, x)};
+}
+
+// Index of the first occurrence of x, or -1
+int firstOccurrence(const int arr[], int n, int x) {
+    int i = lowerBound(arr, n, x);
+    return (i < n && arr[i] == x) ? i : -1;
+}
+
+// Index of the last occurrence of x, or -1
+int lastOccurrence(const int arr[], int n, int x) {
+    int i = upperBound(arr, n, x) - 1;
+    return (i >= 0 && arr[i] == x) ? i : -1;
+}
+
+// Number of elements with lo <= arr[i] <= hi
+int rangeCount(const int arr[], int n, int lo, int hi) {
+    if (lo > hi) return 0;
+    return upperBound(arr, n, hi) - lowerBound(arr, n, lo);
+}
+
+// Index of the k-th (1-based) element >= x, or -1 if fewer than k exist
+int kthAtLeast(const int arr[], int n, int x, int k) {
+    if (k <= 0) return -1;
+    long long i = (long long)lowerBound(arr, n, x) + k - 1;
+    return i < n ? (int)i : -1;
+}
+
+// ==================== BATCH API ====================
+
+/**
+ * Lockstep bound search for up to BATCH_LANES targets at once.
+ * strict = false gives lower bounds, strict = true upper bounds.
+ */
+void boundBatch(const int arr[], int n, const int targets[], int count, bool strict, int out[]) {
+    if (n <= 0) {
+        fill(out, out + count, 0);
+        return;
+    }
+
+    const int* base[BATCH_LANES];
+    for (int q = 0; q < count; q++)
+        base[q] = arr;
+
+    // Every lane shares the same length sequence, so one loop drives them all
+    int len = n;
+    while (len > 1) {
+        int half = len / 2;
+        int nextHalf = (len - half) / 2;
+        for (int q = 0; q < count; q++) {
+            int x = targets[q];
+            // The next probe is base[nextHalf - 1] if this step stays, base[half + nextHalf - 1] if it moves
+            if (nextHalf > 0) {
+                __builtin_prefetch(base[q] + nextHalf - 1);
+                __builtin_prefetch(base[q] + half + nextHalf - 1);
+            }
+            base[q] = boundStep(base[q], half, [x, strict](int v) { return strict ? v <= x : v < x; });
+        }
+        len -= half;
+    }
+
+    for (int q = 0; q < count; q++) {
+        int x = targets[q];
+        out[q] = boundFinish(arr, base[q], [x, strict](int v) { return strict ? v <= x : v < x; });
+    }
+}
+
+/**
+ * Range counts for m (lo[i], hi[i]) pairs in one call
+ * @return: result[i] = number of elements with lo[i] <= arr[j] <= hi[i]
+ */
+vector<int> rangeCountBatch(const int arr[], int n, const int lo[], const int hi[], int m) {
+    vector<int> result(m, 0);
+    if (n <= 0) return result;
+
+    int lower[BATCH_LANES], upper[BATCH_LANES];
+    for (int start = 0; start < m; start += BATCH_LANES) {
+        int count = min(BATCH_LANES, m - start);
+        boundBatch(arr, n, lo + start, count, false, lower);
+        boundBatch(arr, n, hi + start, count, true, upper);
+        for (int q = 0; q < count; q++)
+            result[start + q] = (lo[start + q] > hi[start + q]) ? 0 : max(0, upper[q] - lower[q]);
+    }
+    return result;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main() {
+    // Test Case 1: duplicates
+    cout << "Test Case 1:" << endl;
+    int arr[] = {1, 2, 2, 2, 5, 7, 7, 9};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    pair<int, int> r = equalRange(arr, n, 2);
+    cout << "lowerBound(2)=" << lowerBound(arr, n, 2) << " upperBound(2)=" << upperBound(arr, n, 2)
+         << " equalRange(2)=[" << r.first << "," << r.second << ")" << endl;
+    cout << "first(7)=" << firstOccurrence(arr, n, 7) << " last(7)=" << lastOccurrence(arr, n, 7)
+         << " first(3)=" << firstOccurrence(arr, n, 3) << endl;
+    cout << "rangeCount(2,7)=" << rangeCount(arr, n, 2, 7) << " kthAtLeast(3,2)=" << kthAtLeast(arr, n, 3, 2)
+         << " kthAtLeast(8,3)=" << kthAtLeast(arr, n, 8, 3) << endl;
+    cout << "Expected: lowerBound(2)=1 upperBound(2)=4 equalRange(2)=[1,4)" << endl;
+    cout << "          first(7)=5 last(7)=6 first(3)=-1" << endl;
+    cout << "          rangeCount(2,7)=6 kthAtLeast(3,2)=5 kthAtLeast(8,3)=-1" << endl << endl;
+
+    // Test Case 2: every query vs std:: algorithms on random arrays
+    cout << "Test Case 2 (vs std::lower_bound / upper_bound):" << endl;
+    mt19937 rng(11);
+    bool ok = true;
+    for (int t = 0; t < 500; t++) {
+        int size = rng() % 300;
+        vector<int> a(size);
+        for (int& x : a) x = rng() % 40 - 20;
+        sort(a.begin(), a.end());
+        for (int x = -25; x <= 25; x++) {
+            int lb = lower_bound(a.begin(), a.end(), x) - a.begin();
+            int ub = upper_bound(a.begin(), a.end(), x) - a.begin();
+            ok &= lowerBound(a.data(), size, x) == lb;
+            ok &= upperBound(a.data(), size, x) == ub;
+            ok &= firstOccurrence(a.data(), size, x) == (lb < ub ? lb : -1);
+            ok &= lastOccurrence(a.data(), size, x) == (lb < ub ? ub - 1 : -1);
+            ok &= kthAtLeast(a.data(), size, x, 3) == (lb + 2 < size ? lb + 2 : -1);
+            int y = x + (int)(rng() % 10) - 3;
+            int expected = (x <= y) ? (int)(upper_bound(a.begin(), a.end(), y) - a.begin()) - lb : 0;
+            ok &= rangeCount(a.data(), size, x, y) == expected;
+        }
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: batch range counts vs single queries, then timing
+    cout << "Test Case 3 (batch rangeCount, n = 2^24, m = 2 * 10^6):" << endl;
+    int big = 1 << 24, m = 2000000;
+    vector<int> keys(big);
+    for (int& x : keys) x = rng() % (big / 4);  // ~4 copies of each value
+    sort(keys.begin(), keys.end());
+    vector<int> lo(m), hi(m);
+    for (int i = 0; i < m; i++) {
+        lo[i] = rng() % (big / 4);
+        hi[i] = lo[i] + (int)(rng() % 1000) - 10;  // some empty ranges (hi < lo)
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<int> single(m);
+    for (int i = 0; i < m; i++) single[i] = rangeCount(keys.data(), big, lo[i], hi[i]);
+    double singleMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<int> batch = rangeCountBatch(keys.data(), big, lo.data(), hi.data(), m);
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "  results match: " << (single == batch ? "PASSED ✓" : "FAILED ✗") << endl;
+    cout << "  one query at a time: " << singleMs << " ms   batch: " << batchMs << " ms" << endl;
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+/**
+ * SIMD Merge Sort with Bitonic Merge Networks
+ *
+ * Problem: The inner loop of merge() moves one element per iteration and
+ * branches on L[i] <= R[j]. Random data mispredicts that branch about half the
+ * time, and the loop never uses the vector units.
+ *
+ * Approach: Bitonic networks in vector registers
+ * - Merge kernel: load W sorted ints from each run, reverse one register and
+ *   take lane-wise min / max. Both halves are then bitonic and are sorted
+ *   with log2(W) compare-exchange stages. The low W values are final; the high
+ *   W values are carried into the next step, merged with the next block of
+ *   whichever run has the smaller head. W = 8 (AVX2) or 16 (AVX-512).
+ * - Base case: ranges of at most W elements are sorted inside one register
+ *   with a full bitonic sorting network (padding with INT_MAX)
+ * - Runtime CPU dispatch: the kernels are compiled with per-function target
+ *   attributes and picked once with __builtin_cpu_supports, so the same binary
+ *   runs on any x86-64 host; the scalar merge from mergesort.cpp is the fallback
+ * - The recursion is the original top-down mergeSort. Only the left half is
+ *   copied out (the output never overtakes unread right-half elements), into
+ *   one buffer allocated per sort instead of VLAs per call.
+ *
+ * Equal ints cannot be told apart, so the output is identical to mergeSort.
+ *
+ * Time Complexity: O(N log N), with about W elements per merge step
+ * Space Complexity: O(N) buffer (left halves only, so N / 2)
+ *
+ * Build: g++ -std=c++17 -O2 simd_mergesort.cpp   (no -mavx2 needed)
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <climits>
+#include <immintrin.h>
+using namespace std;
+
+// ==================== SCALAR KERNELS (fallback) ====================
+
+/**
+ * Merge sorted A[0, na) and B[0, nb) into out. out may alias B's storage as
+ * long as out + na == B (the in-place layout used by mergeSort).
+ */
+void mergeRunsScalar(const int* A, int na, const int* B, int nb, int* out) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        if (A[i] <= B[j])
+            out[k++] = A[i++];
+        else
+            out[k++] = B[j++];
+    }
+
+    while (i < na)
+        out[k++] = A[i++];
+
+    while (j < nb)
+        out[k++] = B[j++];
+}
+
+void sortSmallScalar(int* a, int n) {
+    // Insertion sort
+    for (int i = 1; i < n; i++) {
+        int key = a[i], j = i - 1;
+        while (j >= 0 && a[j] > key) {
+            a[j + 1] = a[j];
+            j--;
+        }
+        a[j + 1] = key;
+    }
+}
+
+/**
+ * Finish a SIMD merge: `carry` holds W sorted values that are all >= what was
+ * already written; merge it with the leftovers of A and B (3-way, scalar)
+ */
+void mergeTail(const int* carry, int nc, const int* A, int na, const int* B, int nb, int* out) {
+    int c = 0, i = 0, j = 0, k = 0;
+    while (c < nc || i < na || j < nb) {
+        int best = INT_MAX, which = -1;
+        // Ties prefer carry, then A, then B (carry holds earlier elements)
+        if (c < nc) { best = carry[c]; which = 0; }
+        if (i < na && (which < 0 || A[i] < best)) { best = A[i]; which = 1; }
+        if (j < nb && (which < 0 || B[j] < best)) { best = B[j]; which = 2; }
+        out[k++] = best;
+        if (which == 0) c++;
+        else if (which == 1) i++;
+        else j++;
+    }
+}
+
+// ==================== NETWORK TABLES ====================
+
+/**
+ * Permutation (partner = i ^ j) and "take max" lane masks for every
+ * compare-exchange stage, for a register of W lanes.
+ * Sorting stages run k = 2..W, j = k/2..1; merge stages run j = W/2..1.
+ */
+struct NetworkTables {
+    int W;
+    vector<vector<int>> sortPerm, sortMax;   // full bitonic sort
+    vector<vector<int>> mergePerm, mergeMax; // bitonic clean-up after min/max
+    vector<int> reverse;
+
+    explicit NetworkTables(int width) : W(width), reverse(width) {
+        for (int k = 2; k <= W; k *= 2) {
+            for (int j = k / 2; j >= 1; j /= 2) {
+                vector<int> perm(W), takeMax(W);
+                for (int i = 0; i < W; i++) {
+                    bool ascending = (i & k) == 0 || k == W;
+                    bool upper = (i & j) != 0;
+                    perm[i] = i ^ j;
+                    takeMax[i] = (upper == ascending) ? -1 : 0;
+                }
+                sortPerm.push_back(perm);
+                sortMax.push_back(takeMax);
+            }
+        }
+        for (int j = W / 2; j >= 1; j /= 2) {
+            vector<int> perm(W), takeMax(W);
+            for (int i = 0; i < W; i++) {
+                perm[i] = i ^ j;
+                takeMax[i] = (i & j) ? -1 : 0;
+            }
+            mergePerm.push_back(perm);
+            mergeMax.push_back(takeMax);
+        }
+        for (int i = 0; i < W; i++)
+            reverse[i] = W - 1 - i;
+    }
+};
+
+static const NetworkTables tables8(8);
+static const NetworkTables tables16(16);
+
+// ==================== AVX2 KERNELS (W = 8) ====================
+
+__attribute__((target("avx2")))
+static inline __m256i load8(const vector<int>& v) {
+    return _mm256_loadu_si256((const __m256i*)v.data());
+}
+
+__attribute__((target("avx2")))
+static inline __m256i compareExchange8(__m256i v, __m256i perm, __m256i takeMax) {
+    __m256i p = _mm256_permutevar8x32_epi32(v, perm);
+    __m256i mn = _mm256_min_epi32(v, p), mx = _mm256_max_epi32(v, p);
+    return _mm256_blendv_epi8(mn, mx, takeMax);
+}
+
+// Sort a bitonic register ascending (3 stages)
+__attribute__((target("avx2")))
+static inline __m256i bitonicClean8(__m256i v, const __m256i* perm, const __m256i* takeMax) {
+    for (int s = 0; s < 3; s++)
+        v = compareExchange8(v, perm[s], takeMax[s]);
+    return v;
+}
+
+__attribute__((target("avx2")))
+void sortSmallAvx2(int* a, int n) {
+    alignas(32) int lanes[8];
+    for (int i = 0; i < 8; i++)
+        lanes[i] = (i < n) ? a[i] : INT_MAX;
+
+    __m256i v = _mm256_load_si256((const __m256i*)lanes);
+    for (size_t s = 0; s < tables8.sortPerm.size(); s++)
+        v = compareExchange8(v, load8(tables8.sortPerm[s]), load8(tables8.sortMax[s]));
+    _mm256_store_si256((__m256i*)lanes, v);
+
+    copy(lanes, lanes + n, a);
+}
+
+__attribute__((target("avx2")))
+void mergeRunsAvx2(const int* A, int na, const int* B, int nb, int* out) {
+    if (na < 8 || nb < 8) {
+        mergeRunsScalar(A, na, B, nb, out);
+        return;
+    }
+
+    __m256i perm[3], takeMax[3];
+    for (int s = 0; s < 3; s++) {
+        perm[s] = load8(tables8.mergePerm[s]);
+        takeMax[s] = load8(tables8.mergeMax[s]);
+    }
+    const __m256i rev = load8(tables8.reverse);
+
+    __m256i carry = _mm256_loadu_si256((const __m256i*)A);
+    __m256i next = _mm256_loadu_si256((const __m256i*)B);
+    int ia = 8, ib = 8, k = 0;
+
+    while (true) {
+        // Merge 8 + 8: reverse one side, min/max, clean both halves
+        __m256i r = _mm256_permutevar8x32_epi32(next, rev);
+        __m256i lo = bitonicClean8(_mm256_min_epi32(carry, r), perm, takeMax);
+        carry = bitonicClean8(_mm256_max_epi32(carry, r), perm, takeMax);
+        _mm256_storeu_si256((__m256i*)(out + k), lo);
+        k += 8;
+
+        // Next block comes from the run whose head is smaller
+        bool fromA = (ia + 8 <= na) && (ib + 8 > nb || A[ia] <= B[ib]);
+        bool fromB = !fromA && (ib + 8 <= nb);
+        if (!fromA && !fromB) break;
+        // A run with fewer than 8 left must be drained before its head is passed
+        if (fromA && ib < nb && ib + 8 > nb && B[ib] < A[ia]) break;
+        if (fromB && ia < na && ia + 8 > na && A[ia] < B[ib]) break;
+
+        if (fromA) { next = _mm256_loadu_si256((const __m256i*)(A + ia)); ia += 8; }
+        else       { next = _mm256_loadu_si256((const __m256i*)(B + ib)); ib += 8; }
+    }
+
+    alignas(32) int rest[8];
+    _mm256_store_si256((__m256i*)rest, carry);
+    mergeTail(rest, 8, A + ia, na - ia, B + ib, nb - ib, out + k);
+}
+
+// ==================== AVX-512 KERNELS (W = 16) ====================
+
+// GCC's unmasked AVX-512 intrinsics pass an uninitialized vector as the merge
+// source, which -Wmaybe-uninitialized reports once they are inlined. The
+// zero-masking forms with every lane selected compile to the same instructions
+const __mmask16 ALL16 = 0xFFFF;
+
+__attribute__((target("avx512f")))
+static inline __m512i load16(const vector<int>& v) {
+    return _mm512_loadu_si512(v.data());
+}
+
+__attribute__((target("avx512f")))
+static inline __mmask16 mask16(const vector<int>& v) {
+    return _mm512_cmpneq_epi32_mask(load16(v), _mm512_setzero_si512());
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i compareExchange16(__m512i v, __m512i perm, __mmask16 takeMax) {
+    __m512i p = _mm512_maskz_permutexvar_epi32(ALL16, perm, v);
+    __m512i mn = _mm512_maskz_min_epi32(ALL16, v, p), mx = _mm512_maskz_max_epi32(ALL16, v, p);
+    return _mm512_mask_blend_epi32(takeMax, mn, mx);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i bitonicClean16(__m512i v, const __m512i* perm, const __mmask16* takeMax) {
+    for (int s = 0; s < 4; s++)
+        v = compareExchange16(v, perm[s], takeMax[s]);
+    return v;
+}
+
+__attribute__((target("avx512f")))
+void sortSmallAvx512(int* a, int n) {
+    __mmask16 valid = (__mmask16)((1u << n) - 1);
+    __m512i v = _mm512_mask_loadu_epi32(_mm512_set1_epi32(INT_MAX), valid, a);
+    for (size_t s = 0; s < tables16.sortPerm.size(); s++)
+        v = compareExchange16(v, load16(tables16.sortPerm[s]), mask16(tables16.sortMax[s]));
+    _mm512_mask_storeu_epi32(a, valid, v);
+}
+
+__attribute__((target("avx512f")))
+void mergeRunsAvx512(const int* A, int na, const int* B, int nb, int* out) {
+    if (na < 16 || nb < 16) {
+        mergeRunsScalar(A, na, B, nb, out);
+        return;
+    }
+
+    __m512i perm[4];
+    __mmask16 takeMax[4];
+    for (int s = 0; s < 4; s++) {
+        perm[s] = load16(tables16.mergePerm[s]);
+        takeMax[s] = mask16(tables16.mergeMax[s]);
+    }
+    const __m512i rev = load16(tables16.reverse);
+
+    __m512i carry = _mm512_loadu_si512(A);
+    __m512i next = _mm512_loadu_si512(B);
+    int ia = 16, ib = 16, k = 0;
+
+    while (true) {
+        __m512i r = _mm512_maskz_permutexvar_epi32(ALL16, rev, next);
+        __m512i lo = bitonicClean16(_mm512_maskz_min_epi32(ALL16, carry, r), perm, takeMax);
+        carry = bitonicClean16(_mm512_maskz_max_epi32(ALL16, carry, r), perm, takeMax);
+        _mm512_storeu_si512(out + k, lo);
+        k += 16;
+
+        bool fromA = (ia + 16 <= na) && (ib + 16 > nb || A[ia] <= B[ib]);
+        bool fromB = !fromA && (ib + 16 <= nb);
+        if (!fromA && !fromB) break;
+        if (fromA && ib < nb && ib + 16 > nb && B[ib] < A[ia]) break;
+        if (fromB && ia < na && ia + 16 > na && A[ia] < B[ib]) break;
+
+        if (fromA) { next = _mm512_loadu_si512(A + ia); ia += 16; }
+        else       { next = _mm512_loadu_si512(B + ib); ib += 16; }
+    }
+
+    alignas(64) int rest[16];
+    _mm512_store_si512(rest, carry);
+    mergeTail(rest, 16, A + ia, na - ia, B + ib, nb - ib, out + k);
+}
+
+// ==================== RUNTIME DISPATCH ====================
+
+struct MergeKernel {
+    string name;
+    int width;  // largest range sortSmall handles
+    void (*mergeRuns)(const int*, int, const int*, int, int*);
+    void (*sortSmall)(int*, int);
+};
+
+const MergeKernel scalarKernel = {"scalar", 16, mergeRunsScalar, sortSmallScalar};
+const MergeKernel avx2Kernel = {"avx2", 8, mergeRunsAvx2, sortSmallAvx2};
+const MergeKernel avx512Kernel = {"avx512", 16, mergeRunsAvx512, sortSmallAvx512};
+
+const MergeKernel* detectKernel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return &avx512Kernel;
+    if (__builtin_cpu_supports("avx2")) return &avx2Kernel;
+    return &scalarKernel;
+}
+
+// Picked once at startup; tests may override it
+const MergeKernel* activeKernel = detectKernel();
+
+// ==================== MERGE SORT ====================
+
+/**
+ * Same contract as the original merge(): arr[left..mid] and arr[mid+1..right]
+ * are sorted and get merged in place. Only the left half is copied to buffer.
+ */
+void merge(int arr[], int left, int mid, int right, int* buffer) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    // Already in order: nothing to do (common on presorted input)
+    if (arr[mid] <= arr[mid + 1])
+        return;
+
+    copy(arr + left, arr + mid + 1, buffer);
+    activeKernel->mergeRuns(buffer, n1, arr + mid + 1, n2, arr + left);
+}
+
+void mergeSort(int arr[], int left, int right, int* buffer) {
+    if (right - left + 1 <= activeKernel->width) {
+        if (left < right)
+            activeKernel->sortSmall(arr + left, right - left + 1);
+        return;
+    }
+
+    int mid = left + (right - left) / 2;
+
+    mergeSort(arr, left, mid, buffer);
+    mergeSort(arr, mid + 1, right, buffer);
+
+    merge(arr, left, mid, right, buffer);
+}
+
+/**
+ * Entry point with the original signature: sorts arr[left..right]
+ */
+void mergeSort(int arr[], int left, int right) {
+    if (left >= right) return;
+    vector<int> buffer((right - left) / 2 + 1);
+    mergeSort(arr, left, right, buffer.data());
+}
+
+// ==================== REFERENCE (original mergesort.cpp) ====================
+
+void mergeReference(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    vector<int> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSortReference(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSortReference(arr, left, mid);
+        mergeSortReference(arr, mid + 1, right);
+
+        mergeReference(arr, left, mid, right);
+    }
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+bool supported(const MergeKernel* k) {
+    if (k == &avx512Kernel) return __builtin_cpu_supports("avx512f");
+    if (k == &avx2Kernel) return __builtin_cpu_supports("avx2");
+    return true;
+}
+
+int main() {
+    cout << "Detected kernel: " << activeKernel->name << endl << endl;
+
+    // Test Case 1: the original example
+    cout << "Test Case 1:" << endl;
+    int arr[] = {38, 27, 43, 3, 9, 82, 10};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    mergeSort(arr, 0, n - 1);
+    cout << "Sorted array: ";
+    for (int i = 0; i < n; i++)
+        cout << arr[i] << " ";
+    cout << endl << "Expected: 3 9 10 27 38 43 82" << endl << endl;
+
+    // Test Case 2: every kernel vs the reference on many sizes and shapes
+    cout << "Test Case 2 (all kernels vs reference):" << endl;
+    const MergeKernel* detected = activeKernel;
+    mt19937 rng(7);
+    for (const MergeKernel* k : {&scalarKernel, &avx2Kernel, &avx512Kernel}) {
+        if (!supported(k)) {
+            cout << "  " << k->name << ": not supported on this CPU, skipped" << endl;
+            continue;
+        }
+        activeKernel = k;
+        bool ok = true;
+        for (int t = 0; t < 600; t++) {
+            int size = (t < 100) ? t : 1 + rng() % 20000;
+            int range = (t % 3 == 0) ? 4 : INT_MAX;  // every third case: heavy duplicates
+            vector<int> a(size);
+            for (int& x : a) x = (range == 4) ? (int)(rng() % 4) : (int)rng();
+            if (t % 7 == 0) sort(a.begin(), a.end());              // presorted
+            if (t % 11 == 0) sort(a.rbegin(), a.rend());           // reversed
+            vector<int> b = a;
+            if (size) {
+                mergeSort(a.data(), 0, size - 1);
+                mergeSortReference(b.data(), 0, size - 1);
+            }
+            ok &= a == b;
+        }
+        cout << "  " << k->name << ": " << (ok ? "PASSED ✓" : "FAILED ✗") << endl;
+    }
+    cout << endl;
+
+    // Test Case 3: throughput
+    cout << "Test Case 3 (timing, 4 * 10^6 random ints):" << endl;
+    vector<int> data(4000000);
+    for (int& x : data) x = (int)rng();
+    {
+        vector<int> a = data;
+        auto start = chrono::steady_clock::now();
+        mergeSortReference(a.data(), 0, a.size() - 1);
+        cout << "  reference: " << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+    }
+    for (const MergeKernel* k : {&scalarKernel, &avx2Kernel, &avx512Kernel}) {
+        if (!supported(k)) continue;
+        activeKernel = k;
+        vector<int> a = data;
+        auto start = chrono::steady_clock::now();
+        mergeSort(a.data(), 0, a.size() - 1);
+        cout << "  " << k->name << ": " << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms" << endl;
+    }
+    activeKernel = detected;
+
+    return 0;
+}
@@ -0,0 +1,1039 @@
+/**
+ * Adaptive Dispatch (pick the sort / search / tree backend from input stats)
+ *
+ * Problem: The repo now has several variants of each algorithm (recursive vs
+ * iterative, comparison vs radix, serial vs parallel, pointer vs flat). Which
+ * one is fastest depends on the input, and callers should not have to choose
+ * by hand.
+ *
+ * Approach: Cheap statistics -> cost model -> cheapest backend, logged
+ * - ArrayStats samples up to STAT_SAMPLES evenly spaced adjacent pairs for
+ *   presortedness and key range. TreeStats walks at most TREE_SAMPLE_NODES
+ *   nodes and is exact for small trees. For larger trees, random root-to-leaf
+ *   descents estimate the height, and Knuth's estimator (the product of the
+ *   branching factors along a descent) estimates the size
+ * - CostTable holds one constant (ns per unit of work) for each backend. Each
+ *   backend's cost is that constant times its work model, e.g. n log2 n for
+ *   the top-down merge sort, n log2(runs) for the natural merge sort, and
+ *   n * digits for radix. calibrate() times every backend on synthetic inputs
+ *   and refits the constants; "--calibrate" prints a table to paste into
+ *   DEFAULT_COSTS
+ * - Backends that cannot run safely get an infinite cost: the recursive tree
+ *   methods unless the tree is known to be at most RECURSION_LIMIT deep (a
+ *   sampled height is only a lower bound, so estimated trees always go
+ *   iterative), parallel backends on a single core, and mergeSort's VLAs
+ *   beyond VLA_LIMIT elements
+ * - Decisions are written to the Dispatcher's log stream, if one is set, as
+ *   one line with the statistics, every candidate's estimate and the pick. A
+ *   line is written only when the pick differs from the previous pick for
+ *   the same operation, so a hot loop does not flood the log. The most recent
+ *   pick is also kept in lastChoice for tests
+ * - Searches are planned once per array (planSearch) and reused across queries,
+ *   so per-query dispatch costs nothing. binarySearch() keeps the plan of the
+ *   last array it saw and only replans when a different array (pointer or
+ *   size) comes in
+ *
+ * Every backend returns what the original returns; binarySearch may report any
+ * index of an equal element, as the original does.
+ *
+ * Usage: ./adaptive_dispatch [--calibrate]
+ * Build: g++ -std=c++17 -O2 -pthread adaptive_dispatch.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <array>
+#include <map>
+#include <set>
+#include <queue>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+const int STAT_SAMPLES = 1024;         // adjacent pairs sampled for ArrayStats
+const int TREE_SAMPLE_NODES = 4096;    // nodes visited before TreeStats estimates
+const int TREE_DESCENTS = 32;          // random descents for height / size estimates
+const int RECURSION_LIMIT = 20000;     // deeper trees never take a recursive backend
+const int VLA_LIMIT = 1 << 20;         // mergeSort's stack buffers stay below 8 MB
+const int INSERTION_MAX = 64;          // beyond this a missed descent could cost O(N^2)
+const double INF_COST = 1e300;
+
+// ==================== ORIGINAL ALGORITHMS ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL) return 0;
+        int lh = depth(root->left, diameter);
+        int rh = depth(root->right, diameter);
+        diameter = max(diameter, lh + rh);
+        return 1 + max(lh, rh);
+    }
+
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+};
+
+// ==================== ARRAY BACKENDS ====================
+
+void insertionSort(int arr[], int n) {
+    for (int i = 1; i < n; i++) {
+        int x = arr[i], j = i - 1;
+        while (j >= 0 && arr[j] > x) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = x;
+    }
+}
+
+// Merge src[a, b) and src[b, c) into dst[a, c), stable
+void mergeInto(const int* src, int* dst, size_t a, size_t b, size_t c) {
+    size_t i = a, j = b, k = a;
+    while (i < b && j < c) dst[k++] = (src[j] < src[i]) ? src[j++] : src[i++];
+    while (i < b) dst[k++] = src[i++];
+    while (j < c) dst[k++] = src[j++];
+}
+
+/**
+ * Natural merge sort: merges the existing non-decreasing runs pairwise,
+ * so presorted input needs few passes (one pass to find runs if sorted)
+ */
+void naturalMergeSort(int arr[], size_t n) {
+    if (n < 2) return;
+    vector<size_t> runs = {0};
+    for (size_t i = 1; i < n; i++)
+        if (arr[i] < arr[i - 1]) runs.push_back(i);
+    runs.push_back(n);
+    if (runs.size() == 2) return;
+
+    vector<int> buffer(n);
+    int* src = arr;
+    int* dst = buffer.data();
+    while (runs.size() > 2) {
+        vector<size_t> merged = {0};
+        for (size_t r = 0; r + 1 < runs.size(); r += 2) {
+            size_t a = runs[r], b = runs[r + 1], c = (r + 2 < runs.size()) ? runs[r + 2] : b;
+            mergeInto(src, dst, a, b, c);
+            merged.push_back(c);
+        }
+        runs.swap(merged);
+        swap(src, dst);
+    }
+    if (src != arr) copy(src, src + n, arr);
+}
+
+/**
+ * LSD radix sort on (x - min), 8-bit digits, only as many passes as the key
+ * range needs
+ */
+void radixSort(int arr[], size_t n) {
+    if (n < 2) return;
+    int lo = *min_element(arr, arr + n), hi = *max_element(arr, arr + n);
+    uint32_t range = (uint32_t)((int64_t)hi - lo);
+    vector<int> buffer(n);
+    int* src = arr;
+    int* dst = buffer.data();
+    for (int shift = 0; shift < 32 && (range >> shift) != 0; shift += 8) {
+        size_t count[257] = {0};
+        for (size_t i = 0; i < n; i++) count[(((uint32_t)((int64_t)src[i] - lo)) >> shift & 0xFF) + 1]++;
+        for (int d = 0; d < 256; d++) count[d + 1] += count[d];
+        for (size_t i = 0; i < n; i++) dst[count[((uint32_t)((int64_t)src[i] - lo)) >> shift & 0xFF]++] = src[i];
+        swap(src, dst);
+    }
+    if (src != arr) copy(src, src + n, arr);
+}
+
+/**
+ * Each thread natural-merge-sorts one chunk, then chunks are merged pairwise
+ */
+void parallelMergeSort(int arr[], size_t n, unsigned threads) {
+    threads = max(1u, min<unsigned>(threads, n / 4096 + 1));
+    vector<size_t> bounds(threads + 1);
+    for (unsigned t = 0; t <= threads; t++) bounds[t] = n * t / threads;
+
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back(naturalMergeSort, arr + bounds[t], bounds[t + 1] - bounds[t]);
+    naturalMergeSort(arr, bounds[1]);
+    for (auto& w : workers) w.join();
+
+    vector<int> buffer(n);
+    int* src = arr;
+    int* dst = buffer.data();
+    while (bounds.size() > 2) {
+        vector<size_t> merged = {0};
+        workers.clear();
+        for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            size_t a = bounds[r], b = bounds[r + 1], c = (r + 2 < bounds.size()) ? bounds[r + 2] : b;
+            workers.emplace_back(mergeInto, src, dst, a, b, c);
+            merged.push_back(c);
+        }
+        for (auto& w : workers) w.join();
+        bounds.swap(merged);
+        swap(src, dst);
+    }
+    if (src != arr) copy(src, src + n, arr);
+}
+
+int linearSearch(const int arr[], int n, int target) {
+    for (int i = 0; i < n; i++)
+        if (arr[i] == target) return i;
+    return -1;
+}
+
+// Branchless lower bound (see search_bounds.cpp), then an equality check
+int branchlessSearch(const int arr[], int n, int target) {
+    if (n <= 0) return -1;
+    const int* base = arr;
+    int len = n;
+    while (len > 1) {
+        int half = len / 2;
+        base = (base[half - 1] < target) ? base + half : base;
+        len -= half;
+    }
+    int i = (base - arr) + (*base < target ? 1 : 0);
+    return (i < n && arr[i] == target) ? i : -1;
+}
+
+// Interpolation search, falling back to bisection after a bad guess
+int interpolationSearch(const int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+    while (left <= right && target >= arr[left] && target <= arr[right]) {
+        if (arr[right] == arr[left]) return arr[left] == target ? left : -1;
+        int64_t span = (int64_t)arr[right] - arr[left];
+        int mid = left + (int)(((int64_t)target - arr[left]) * (right - left) / span);
+        if (arr[mid] == target) return mid;
+        if (arr[mid] < target) left = mid + 1;
+        else right = mid - 1;
+        // Bisect once as well, so skewed keys cannot degrade to linear time
+        int half = left + (right - left) / 2;
+        if (left <= right) {
+            if (arr[half] == target) return half;
+            if (arr[half] < target) left = half + 1;
+            else right = half - 1;
+        }
+    }
+    return -1;
+}
+
+// ==================== TREE BACKENDS ====================
+
+/**
+ * Preorder with child links as indices, so a reverse sweep is a post-order
+ * without recursion (same idea as forest_batch.cpp)
+ */
+struct FlatTree {
+    vector<TreeNode*> nodes;
+    vector<int> left, right;  // -1 = none
+
+    explicit FlatTree(TreeNode* root) {
+        if (!root) return;
+        vector<pair<TreeNode*, int>> stack = {{root, -1}};  // node, parent slot
+        while (!stack.empty()) {
+            auto [node, from] = stack.back();
+            stack.pop_back();
+            int id = nodes.size();
+            nodes.push_back(node);
+            left.push_back(-1);
+            right.push_back(-1);
+            if (from >= 0) (from & 1 ? right : left)[from >> 1] = id;
+            if (node->right) stack.push_back({node->right, id * 2 + 1});
+            if (node->left) stack.push_back({node->left, id * 2});
+        }
+    }
+};
+
+int maxPathSumIterative(TreeNode* root) {
+    FlatTree t(root);
+    int maxi = INT_MIN;
+    vector<int> gain(t.nodes.size());
+    for (int i = (int)t.nodes.size() - 1; i >= 0; i--) {
+        int l = t.left[i] < 0 ? 0 : max(0, gain[t.left[i]]);
+        int r = t.right[i] < 0 ? 0 : max(0, gain[t.right[i]]);
+        maxi = max(maxi, l + r + t.nodes[i]->val);
+        gain[i] = t.nodes[i]->val + max(l, r);
+    }
+    return maxi;
+}
+
+int diameterIterative(TreeNode* root) {
+    FlatTree t(root);
+    int diameter = 0;
+    vector<int> height(t.nodes.size());
+    for (int i = (int)t.nodes.size() - 1; i >= 0; i--) {
+        int l = t.left[i] < 0 ? 0 : height[t.left[i]];
+        int r = t.right[i] < 0 ? 0 : height[t.right[i]];
+        diameter = max(diameter, l + r);
+        height[i] = 1 + max(l, r);
+    }
+    return diameter;
+}
+
+vector<int> rightSideViewBfs(TreeNode* root) {
+    vector<int> result;
+    vector<TreeNode*> level, next;
+    if (root) level.push_back(root);
+    while (!level.empty()) {
+        result.push_back(level.back()->val);
+        next.clear();
+        for (TreeNode* node : level) {
+            if (node->left) next.push_back(node->left);
+            if (node->right) next.push_back(node->right);
+        }
+        level.swap(next);
+    }
+    return result;
+}
+
+// (column, row, value) records sorted once (see flat_traversals.cpp)
+vector<vector<int>> verticalTraversalSorted(TreeNode* root) {
+    if (!root) return {};
+    vector<TreeNode*> frontier = {root};
+    vector<array<int, 3>> records = {{0, 0, root->val}};
+    for (size_t head = 0; head < frontier.size(); head++) {
+        TreeNode* node = frontier[head];
+        int x = records[head][0], y = records[head][1];
+        if (node->left) {
+            frontier.push_back(node->left);
+            records.push_back({x - 1, y + 1, node->left->val});
+        }
+        if (node->right) {
+            frontier.push_back(node->right);
+            records.push_back({x + 1, y + 1, node->right->val});
+        }
+    }
+    sort(records.begin(), records.end());
+    vector<vector<int>> answer;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (i == 0 || records[i][0] != records[i - 1][0]) answer.emplace_back();
+        answer.back().push_back(records[i][2]);
+    }
+    return answer;
+}
+
+// ==================== STATISTICS ====================
+
+struct ArrayStats {
+    size_t n = 0;
+    double sortedFraction = 1;  // sampled adjacent pairs with a[i] <= a[i + 1]
+    double estimatedRuns = 1;   // non-decreasing runs, extrapolated from the sample
+    int keyBytes = 0;           // bytes of (max - min) over the sample
+    double uniformity = 0;      // 1 = keys follow a straight line (interpolation friendly)
+    unsigned cores = 1;
+};
+
+ArrayStats sampleArray(const int arr[], size_t n, unsigned cores) {
+    ArrayStats s;
+    s.n = n;
+    s.cores = cores;
+    if (n < 2) return s;
+
+    size_t pairs = min<size_t>(STAT_SAMPLES, n - 1);
+    size_t descents = 0;
+    int lo = arr[0], hi = arr[0];
+    for (size_t k = 0; k < pairs; k++) {
+        size_t i = (n - 1) * k / pairs;
+        descents += arr[i + 1] < arr[i];
+        lo = min({lo, arr[i], arr[i + 1]});
+        hi = max({hi, arr[i], arr[i + 1]});
+    }
+    s.sortedFraction = 1.0 - (double)descents / pairs;
+    // A sample without descents does not prove the array sorted: assume one
+    // unseen descent (add-one smoothing) unless every pair was checked
+    double descentRate = (pairs == n - 1) ? (double)descents / pairs : (descents + 1.0) / (pairs + 1);
+    s.estimatedRuns = 1 + descentRate * (n - 1);
+    uint32_t range = (uint32_t)((int64_t)hi - lo);
+    while (s.keyBytes < 4 && (range >> (8 * s.keyBytes)) != 0) s.keyBytes++;
+
+    // Mean distance from the line through the first and last element, in
+    // fractions of the key span; only meaningful for sorted arrays
+    double span = (double)arr[n - 1] - arr[0], error = 0;
+    const int probes = 16;
+    if (span > 0) {
+        for (int p = 1; p < probes; p++) {
+            size_t i = (n - 1) * p / probes;
+            error += fabs(((double)arr[i] - arr[0]) / span - (double)i / (n - 1));
+        }
+        s.uniformity = max(0.0, 1.0 - error / (probes - 1) * 10);
+    }
+    return s;
+}
+
+struct TreeStats {
+    double size = 0;    // exact when exact == true, otherwise Knuth's estimate
+    double height = 0;  // exact, or the deepest random descent (a lower bound)
+    bool exact = false;
+    unsigned cores = 1;
+};
+
+TreeStats sampleTree(TreeNode* root, unsigned cores, uint64_t seed = 45) {
+    TreeStats s;
+    s.cores = cores;
+    if (!root) {
+        s.exact = true;
+        return s;
+    }
+
+    // Small trees: exact size and height from a bounded BFS
+    vector<pair<TreeNode*, int>> seen = {{root, 1}};
+    for (size_t head = 0; head < seen.size() && seen.size() <= (size_t)TREE_SAMPLE_NODES; head++) {
+        auto [node, d] = seen[head];
+        if (node->left) seen.push_back({node->left, d + 1});
+        if (node->right) seen.push_back({node->right, d + 1});
+    }
+    if (seen.size() <= (size_t)TREE_SAMPLE_NODES) {
+        s.exact = true;
+        s.size = seen.size();
+        for (auto& p : seen) s.height = max(s.height, (double)p.second);
+        return s;
+    }
+
+    mt19937_64 rng(seed);
+    double sizeSum = 0;
+    for (int d = 0; d < TREE_DESCENTS; d++) {
+        double weight = 1, estimate = 1, depth = 1;
+        for (TreeNode* node = root; node; depth++) {
+            int children = (node->left != nullptr) + (node->right != nullptr);
+            if (children == 0) break;
+            weight *= children;
+            estimate += weight;
+            node = (children == 2) ? ((rng() & 1) ? node->left : node->right) : (node->left ? node->left : node->right);
+        }
+        sizeSum += estimate;
+        s.height = max(s.height, depth);
+    }
+    s.size = max(sizeSum / TREE_DESCENTS, (double)seen.size());
+    return s;
+}
+
+// ==================== COST TABLE ====================
+
+enum class Backend {
+    // sort
+    TopDownMerge, NaturalMerge, Insertion, Radix, ParallelMerge,
+    // search
+    Linear, Bisect, Branchless, Interpolation,
+    // tree
+    Recursive, Iterative, MapVertical, SortedVertical,
+    Count
+};
+
+const char* backendName(Backend b) {
+    static const char* names[] = {"mergeSort", "natural-merge", "insertion", "radix", "parallel-merge",
+                                  "linear", "binarySearch", "branchless", "interpolation",
+                                  "recursive", "iterative", "map-vertical", "sorted-vertical"};
+    return names[(int)b];
+}
+
+/**
+ * ns per unit of each backend's work model (see cost())
+ */
+struct CostTable {
+    double ns[(int)Backend::Count];
+    double threadStartNs;
+};
+
+// Measured with g++ -O2 on a single-core x86-64 VM (regenerate with --calibrate)
+const CostTable DEFAULT_COSTS = {
+    {9.83, 8.52, 1.67, 4.31, 15.1, 1.17, 11.5, 13.1, 29.6, 31.5, 81.2, 754, 64.6},
+    17772,
+};
+
+double log2n(double n) { return log2(max(2.0, n)); }
+
+// Estimated ns to sort n ints with backend b
+double sortCost(const CostTable& c, Backend b, const ArrayStats& s) {
+    double n = s.n;
+    double w = c.ns[(int)b];
+    switch (b) {
+        case Backend::TopDownMerge:
+            return s.n > (size_t)VLA_LIMIT ? INF_COST : w * n * log2n(n);
+        case Backend::NaturalMerge: {
+            // Merging mostly ordered runs is branch-predictable and far cheaper
+            // per pass than merging random ones (the calibration input)
+            double disorder = min(1.0, max(0.1, 2 * (1 - s.sortedFraction)));
+            return w * n * (1 + ceil(log2(max(1.0, s.estimatedRuns))) * disorder);
+        }
+        case Backend::Insertion:  // each descent moves an element about n/4 slots on average
+            return s.n > (size_t)INSERTION_MAX ? INF_COST : w * n * (1 + (1 - s.sortedFraction) * n / 4);
+        case Backend::Radix:
+            return w * n * (2 + 2 * max(1, s.keyBytes)) + 256 * max(1, s.keyBytes);
+        case Backend::ParallelMerge:
+            if (s.cores < 2) return INF_COST;
+            return w * n * (1 + ceil(log2(max(1.0, s.estimatedRuns / s.cores)))) / s.cores +
+                   w * n * log2n(s.cores) + c.threadStartNs * s.cores;
+        default:
+            return INF_COST;
+    }
+}
+
+// Estimated ns for one lookup
+double searchCost(const CostTable& c, Backend b, const ArrayStats& s) {
+    double n = s.n;
+    double w = c.ns[(int)b];
+    switch (b) {
+        case Backend::Linear: return w * n;
+        case Backend::Bisect: return w * log2n(n);
+        case Backend::Branchless: return w * log2n(n);
+        case Backend::Interpolation:  // log log n when keys are close to uniform
+            return s.uniformity > 0.5 ? w * log2n(log2n(n)) * (2 - s.uniformity) : INF_COST;
+        default: return INF_COST;
+    }
+}
+
+// Estimated ns for one tree query with backend b
+double treeCost(const CostTable& c, Backend b, const TreeStats& s, bool vertical) {
+    double n = max(1.0, s.size);
+    double w = c.ns[(int)b];
+    if (vertical) {
+        if (b == Backend::MapVertical) return w * n;
+        if (b == Backend::SortedVertical) return w * n * log2n(n) / 4;
+        return INF_COST;
+    }
+    // A sampled height can miss a deep chain, so only an exact one proves the stack is safe
+    if (b == Backend::Recursive) return !s.exact || s.height > RECURSION_LIMIT ? INF_COST : w * n;
+    if (b == Backend::Iterative) return w * n;
+    return INF_COST;
+}
+
+// ==================== DISPATCHER ====================
+
+class Dispatcher {
+public:
+    explicit Dispatcher(ostream* log = nullptr, CostTable costs = DEFAULT_COSTS,
+                        unsigned cores = max(1u, thread::hardware_concurrency()))
+        : log(log), costs(costs), cores(cores) {}
+
+    string lastChoice;
+
+    void mergeSort(int arr[], int n) {
+        ArrayStats s = sampleArray(arr, n, cores);
+        Backend b = pick("sort", describe(s), {Backend::TopDownMerge, Backend::NaturalMerge, Backend::Insertion,
+                                              Backend::Radix, Backend::ParallelMerge},
+                         [&](Backend b) { return sortCost(costs, b, s); });
+        runSort(b, arr, n, cores);
+    }
+
+    /**
+     * A search plan: the array's statistics are sampled once, then find()
+     * runs the chosen backend for every query
+     */
+    struct SearchPlan {
+        const int* arr;
+        int n;
+        Backend backend;
+
+        int find(int target) const {
+            switch (backend) {
+                case Backend::Linear: return linearSearch(arr, n, target);
+                case Backend::Branchless: return branchlessSearch(arr, n, target);
+                case Backend::Interpolation: return interpolationSearch(arr, n, target);
+                default: return ::binarySearch((int*)arr, n, target);
+            }
+        }
+    };
+
+    SearchPlan planSearch(const int arr[], int n) {
+        ArrayStats s = sampleArray(arr, n, cores);
+        Backend b = pick("search", describe(s), {Backend::Linear, Backend::Bisect, Backend::Branchless,
+                                                Backend::Interpolation},
+                         [&](Backend b) { return searchCost(costs, b, s); });
+        return {arr, n, b};
+    }
+
+    /**
+     * One query through the cached plan. If the contents change behind the
+     * same pointer and size the plan may be slower, but never wrong
+     */
+    int binarySearch(const int arr[], int n, int target) {
+        if (searchCache.arr != arr || searchCache.n != n)
+            searchCache = planSearch(arr, n);
+        return searchCache.find(target);
+    }
+
+    int maxPathSum(TreeNode* root) {
+        return treeQuery<int>("maxPathSum", root, [](TreeNode* r) { return Solution().maxPathSum(r); },
+                              maxPathSumIterative);
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        return treeQuery<int>("diameter", root, [](TreeNode* r) { return Solution().diameterOfBinaryTree(r); },
+                              diameterIterative);
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        return treeQuery<vector<int>>("rightSideView", root, [](TreeNode* r) { return Solution().rightSideView(r); },
+                                      rightSideViewBfs);
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        TreeStats s = sampleTree(root, cores);
+        Backend b = pick("verticalTraversal", describe(s), {Backend::MapVertical, Backend::SortedVertical},
+                         [&](Backend b) { return treeCost(costs, b, s, true); });
+        return b == Backend::MapVertical ? Solution().verticalTraversal(root) : verticalTraversalSorted(root);
+    }
+
+    static void runSort(Backend b, int arr[], int n, unsigned cores) {
+        switch (b) {
+            case Backend::TopDownMerge: ::mergeSort(arr, 0, n - 1); break;
+            case Backend::NaturalMerge: naturalMergeSort(arr, n); break;
+            case Backend::Insertion: insertionSort(arr, n); break;
+            case Backend::Radix: radixSort(arr, n); break;
+            default: parallelMergeSort(arr, n, cores); break;
+        }
+    }
+
+private:
+    SearchPlan searchCache{nullptr, -1, Backend::Bisect};  // binarySearch()'s current plan
+    map<string, Backend> lastLogged;                        // last pick written per operation
+
+    template <typename R, typename Rec, typename Iter>
+    R treeQuery(const char* what, TreeNode* root, Rec recursive, Iter iterative) {
+        TreeStats s = sampleTree(root, cores);
+        Backend b = pick(what, describe(s), {Backend::Recursive, Backend::Iterative},
+                         [&](Backend b) { return treeCost(costs, b, s, false); });
+        return b == Backend::Recursive ? recursive(root) : iterative(root);
+    }
+
+    template <typename CostFn>
+    Backend pick(const char* what, const string& stats, initializer_list<Backend> candidates, CostFn cost) {
+        Backend best = *candidates.begin();
+        double bestCost = INF_COST * 2;
+        ostringstream line;
+        line << what << " " << stats << " |";
+        for (Backend b : candidates) {
+            double c = cost(b);
+            line << " " << backendName(b) << "=";
+            if (c >= INF_COST) line << "n/a";
+            else line << fixed << setprecision(1) << c / 1000 << "us";
+            if (c < bestCost) {
+                best = b;
+                bestCost = c;
+            }
+        }
+        lastChoice = backendName(best);
+        auto logged = lastLogged.find(what);
+        if (log && (logged == lastLogged.end() || logged->second != best))
+            *log << line.str() << " -> " << lastChoice << "\n";
+        lastLogged[what] = best;
+        return best;
+    }
+
+    static string describe(const ArrayStats& s) {
+        ostringstream out;
+        out << "n=" << s.n << " sorted=" << setprecision(2) << s.sortedFraction << " runs~" << (long long)s.estimatedRuns
+            << " keyBytes=" << s.keyBytes << " uniform=" << s.uniformity << " cores=" << s.cores;
+        return out.str();
+    }
+
+    static string describe(const TreeStats& s) {
+        ostringstream out;
+        out << "size" << (s.exact ? "=" : "~") << (long long)s.size << " height" << (s.exact ? "=" : ">=")
+            << (long long)s.height << " cores=" << s.cores;
+        return out.str();
+    }
+
+    ostream* log;
+    CostTable costs;
+    unsigned cores;
+};
+
+// ==================== CALIBRATION ====================
+
+template <typename Fn>
+double timeNs(Fn fn, int repeats) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) fn();
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / repeats;
+}
+
+/**
+ * Times every backend on synthetic inputs and divides by its work model
+ */
+CostTable calibrate() {
+    CostTable c = DEFAULT_COSTS;
+    mt19937 rng(45);
+    unsigned cores = max(1u, thread::hardware_concurrency());
+
+    const CostTable unit = {{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}, 0};
+
+    // Sorts at 2^20, where the data no longer fits in cache
+    const int sortN = 1 << 20;
+    vector<int> random(sortN);
+    for (int& x : random) x = (int)rng();
+    for (Backend b : {Backend::TopDownMerge, Backend::NaturalMerge, Backend::Radix, Backend::ParallelMerge}) {
+        ArrayStats s = sampleArray(random.data(), sortN, max(2u, cores));
+        vector<int> a;
+        double ns = timeNs([&]() { a = random; Dispatcher::runSort(b, a.data(), sortN, max(2u, cores)); }, 2);
+        c.ns[(int)b] = ns / sortCost(unit, b, s);
+    }
+    {
+        vector<int> small(INSERTION_MAX);
+        for (int& x : small) x = (int)rng();
+        ArrayStats s = sampleArray(small.data(), small.size(), 1);
+        vector<int> a;
+        c.ns[(int)Backend::Insertion] =
+            timeNs([&]() { a = small; insertionSort(a.data(), a.size()); }, 2000) / sortCost(unit, Backend::Insertion, s);
+    }
+    c.threadStartNs = timeNs([]() { thread([]() {}).join(); }, 200);
+
+    // Searches and trees at 2^16
+    const int n = 1 << 16;
+    vector<int> sorted(random.begin(), random.begin() + n);
+    sort(sorted.begin(), sorted.end());
+    ArrayStats s = sampleArray(sorted.data(), n, 1);
+    const int queries = 200000;
+    volatile int sink = 0;
+    for (Backend b : {Backend::Linear, Backend::Bisect, Backend::Branchless, Backend::Interpolation}) {
+        Dispatcher::SearchPlan plan{sorted.data(), b == Backend::Linear ? 64 : n, b};
+        int range = plan.n;
+        double ns = timeNs([&]() {
+            for (int q = 0; q < queries; q++) sink = sink + plan.find(sorted[rng() % range]);
+        }, 1) / queries;
+        ArrayStats ps = s;
+        ps.n = plan.n;
+        c.ns[(int)b] = ns / searchCost(unit, b, ps);
+    }
+
+    // Trees: a random tree of 2^16 nodes
+    vector<TreeNode> pool(n);
+    for (TreeNode& node : pool) node.val = (int)(rng() % 2001) - 1000;
+    vector<TreeNode**> slots = {&pool[0].left, &pool[0].right};
+    for (int i = 1; i < n; i++) {
+        size_t k = rng() % slots.size();
+        *slots[k] = &pool[i];
+        slots[k] = slots.back();
+        slots.pop_back();
+        slots.push_back(&pool[i].left);
+        slots.push_back(&pool[i].right);
+    }
+    TreeStats ts{(double)n, 0, true, 1};
+    c.ns[(int)Backend::Recursive] = timeNs([&]() { sink = sink + Solution().maxPathSum(&pool[0]); }, 20) /
+                                    treeCost(unit, Backend::Recursive, ts, false);
+    c.ns[(int)Backend::Iterative] = timeNs([&]() { sink = sink + maxPathSumIterative(&pool[0]); }, 20) /
+                                    treeCost(unit, Backend::Iterative, ts, false);
+    c.ns[(int)Backend::MapVertical] =
+        timeNs([&]() { sink = sink + Solution().verticalTraversal(&pool[0]).size(); }, 3) /
+        treeCost(unit, Backend::MapVertical, ts, true);
+    c.ns[(int)Backend::SortedVertical] =
+        timeNs([&]() { sink = sink + verticalTraversalSorted(&pool[0]).size(); }, 3) /
+        treeCost(unit, Backend::SortedVertical, ts, true);
+    return c;
+}
+
+void printCosts(const CostTable& c) {
+    cout << "const CostTable DEFAULT_COSTS = {" << endl << "    {";
+    for (int b = 0; b < (int)Backend::Count; b++)
+        cout << (b ? ", " : "") << setprecision(3) << c.ns[b];
+    cout << "}," << endl << "    " << (long long)c.threadStartNs << "," << endl << "};" << endl;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Random tree; with probability `chain` the next node is the previous node's right child
+TreeNode* randomTree(vector<TreeNode>& pool, int n, double chain, mt19937& rng) {
+    pool.assign(n, TreeNode());
+    if (n == 0) return nullptr;
+    for (TreeNode& node : pool) node.val = (int)(rng() % 2001) - 1000;
+    vector<TreeNode**> slots = {&pool[0].left, &pool[0].right};
+    uniform_real_distribution<double> coin(0, 1);
+    for (int i = 1; i < n; i++) {
+        size_t k = coin(rng) < chain ? slots.size() - 1 : rng() % slots.size();
+        *slots[k] = &pool[i];
+        slots[k] = slots.back();
+        slots.pop_back();
+        slots.push_back(&pool[i].left);
+        slots.push_back(&pool[i].right);
+    }
+    return &pool[0];
+}
+
+bool sameSearchResult(const vector<int>& a, int target, int got) {
+    int ref = binarySearch((int*)a.data(), a.size(), target);
+    return (ref < 0) ? got < 0 : (got >= 0 && a[got] == target);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--calibrate") {
+        printCosts(calibrate());
+        return 0;
+    }
+
+    ostringstream log;
+    Dispatcher dispatch(&log, DEFAULT_COSTS, 1);
+    mt19937 rng(45);
+
+    // Test Case 1: choices follow the input statistics
+    cout << "Test Case 1 (choices):" << endl;
+    vector<int> tiny = {5, 2, 9, 1, 7};
+    vector<int> sortedBig(200000), narrow(200000), wide(200000);
+    for (int i = 0; i < 200000; i++) sortedBig[i] = i * 3;
+    swap(sortedBig[100], sortedBig[101]);
+    for (int& x : narrow) x = rng() % 200;
+    for (int& x : wide) x = (int)rng();
+    vector<pair<string, string>> choices;
+    dispatch.mergeSort(tiny.data(), tiny.size());
+    choices.push_back({"tiny array", dispatch.lastChoice});
+    dispatch.mergeSort(sortedBig.data(), sortedBig.size());
+    choices.push_back({"nearly sorted", dispatch.lastChoice});
+    dispatch.mergeSort(narrow.data(), narrow.size());
+    choices.push_back({"keys < 200", dispatch.lastChoice});
+    dispatch.mergeSort(wide.data(), wide.size());
+    choices.push_back({"random 32-bit", dispatch.lastChoice});
+    dispatch.planSearch(tiny.data(), tiny.size());
+    choices.push_back({"search tiny", dispatch.lastChoice});
+    dispatch.planSearch(sortedBig.data(), sortedBig.size());
+    choices.push_back({"search uniform", dispatch.lastChoice});
+    vector<TreeNode> pool;
+    TreeNode* chain = randomTree(pool, 200000, 1.0, rng);
+    dispatch.maxPathSum(chain);
+    choices.push_back({"chain tree", dispatch.lastChoice});
+    // A complete tree of 8191 nodes with a 2,000,000-node chain under one leaf:
+    // every random descent sees height ~13, the recursion would overflow the stack
+    vector<TreeNode> hidden(8191 + 2000000);
+    for (size_t i = 0; i < hidden.size(); i++) hidden[i].val = (int)(i % 7) - 3;
+    for (size_t i = 0; 2 * i + 2 < 8191; i++) {
+        hidden[i].left = &hidden[2 * i + 1];
+        hidden[i].right = &hidden[2 * i + 2];
+    }
+    for (size_t i = 8190; i + 1 < hidden.size(); i++) hidden[i].right = &hidden[i + 1];  // 8190 is the last leaf
+    int hiddenSum = dispatch.maxPathSum(&hidden[0]);
+    choices.push_back({"hidden deep chain", dispatch.lastChoice});
+    for (auto& c : choices) cout << "  " << c.first << " -> " << c.second << endl;
+    bool ok1 = choices[0].second == "insertion" && choices[1].second == "natural-merge" &&
+               choices[2].second == "radix" && choices[4].second == "linear" &&
+               choices[5].second == "interpolation" && choices[6].second == "iterative" &&
+               choices[7].second == "iterative" && hiddenSum == maxPathSumIterative(&hidden[0]);
+    cout << (ok1 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: every sort backend and the dispatcher agree with mergeSort
+    cout << "Test Case 2 (sorts vs mergeSort on 300 random inputs):" << endl;
+    bool ok2 = true;
+    for (int t = 0; t < 300; t++) {
+        int n = rng() % 3000;
+        vector<int> a(n);
+        int range = (t % 3 == 0) ? 50 : INT_MAX;
+        for (int& x : a) x = (int)(rng() % range) - range / 2;
+        if (t % 4 == 1) sort(a.begin(), a.end());
+        vector<int> expected = a;
+        if (n) mergeSort(expected.data(), 0, n - 1);
+        for (Backend b : {Backend::TopDownMerge, Backend::NaturalMerge, Backend::Insertion, Backend::Radix,
+                          Backend::ParallelMerge}) {
+            vector<int> got = a;
+            if (n) Dispatcher::runSort(b, got.data(), n, 3);
+            ok2 &= got == expected;
+        }
+        vector<int> got = a;
+        dispatch.mergeSort(got.data(), n);
+        ok2 &= got == expected;
+    }
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: every search backend agrees with binarySearch
+    cout << "Test Case 3 (searches vs binarySearch):" << endl;
+    bool ok3 = true;
+    for (int t = 0; t < 200; t++) {
+        int n = rng() % 2000;
+        vector<int> a(n);
+        for (int& x : a) x = (t % 2) ? (int)(rng() % 100) : (int)rng();
+        sort(a.begin(), a.end());
+        for (Backend b : {Backend::Linear, Backend::Bisect, Backend::Branchless, Backend::Interpolation}) {
+            Dispatcher::SearchPlan plan{a.data(), n, b};
+            for (int q = 0; q < 50; q++) {
+                int target = (n && q % 2) ? a[rng() % n] : (int)(rng() % 200) - 50;
+                ok3 &= sameSearchResult(a, target, plan.find(target));
+            }
+        }
+        int target = n ? a[n / 2] : 0;
+        ok3 &= sameSearchResult(a, target, dispatch.binarySearch(a.data(), n, target));
+    }
+    // Repeated queries on one array plan once and log at most one line
+    size_t logBefore = log.str().size();
+    for (int q = 0; q < 10000; q++) {
+        int target = sortedBig[rng() % sortedBig.size()];
+        ok3 &= sameSearchResult(sortedBig, target, dispatch.binarySearch(sortedBig.data(), sortedBig.size(), target));
+    }
+    string added = log.str().substr(logBefore);
+    ok3 &= count(added.begin(), added.end(), '\n') <= 1;
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: tree backends agree with Solution (chain trees skip the recursive reference)
+    cout << "Test Case 4 (tree queries vs Solution):" << endl;
+    bool ok4 = true;
+    Solution solution;
+    for (int t = 0; t < 200; t++) {
+        TreeNode* root = randomTree(pool, rng() % (t % 10 ? 500 : 10000), (t % 3) * 0.45, rng);
+        ok4 &= maxPathSumIterative(root) == solution.maxPathSum(root);
+        ok4 &= diameterIterative(root) == solution.diameterOfBinaryTree(root);
+        ok4 &= rightSideViewBfs(root) == solution.rightSideView(root);
+        ok4 &= verticalTraversalSorted(root) == solution.verticalTraversal(root);
+        ok4 &= dispatch.maxPathSum(root) == solution.maxPathSum(root);
+        ok4 &= dispatch.diameterOfBinaryTree(root) == solution.diameterOfBinaryTree(root);
+        ok4 &= dispatch.rightSideView(root) == solution.rightSideView(root);
+        ok4 &= dispatch.verticalTraversal(root) == solution.verticalTraversal(root);
+    }
+    cout << (ok4 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: dispatched vs always-mergeSort on different input shapes
+    cout << "Test Case 5 (2^20 ints, dispatched vs mergeSort):" << endl;
+    const int big = 1 << 20;
+    vector<pair<string, vector<int>>> shapes(4, {"", vector<int>(big)});
+    shapes[0].first = "random";
+    for (int& x : shapes[0].second) x = (int)rng();
+    shapes[1].first = "sorted + 0.1% swaps";
+    for (int i = 0; i < big; i++) shapes[1].second[i] = i;
+    for (int s = 0; s < big / 1000; s++) swap(shapes[1].second[rng() % big], shapes[1].second[rng() % big]);
+    shapes[2].first = "keys < 1000";
+    for (int& x : shapes[2].second) x = rng() % 1000;
+    shapes[3].first = "reversed";
+    for (int i = 0; i < big; i++) shapes[3].second[i] = big - i;
+    bool ok5 = true;
+    for (auto& shape : shapes) {
+        vector<int> a = shape.second, b = shape.second;
+        double baseMs = timeNs([&]() { mergeSort(a.data(), 0, big - 1); }, 1) / 1e6;
+        double dispMs = timeNs([&]() { dispatch.mergeSort(b.data(), big); }, 1) / 1e6;
+        ok5 &= a == b;
+        cout << "  " << left << setw(20) << shape.first << right << " mergeSort " << fixed << setprecision(1)
+             << setw(7) << baseMs << " ms   dispatched (" << dispatch.lastChoice << ") " << setw(7) << dispMs
+             << " ms" << endl;
+    }
+    cout << (ok5 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // The audit log: one line per decision (first few shown)
+    string audit = log.str();
+    cout << "Decision log (first 7 of " << count(audit.begin(), audit.end(), '\n') << " lines):" << endl;
+    istringstream lines(audit);
+    string line;
+    for (int i = 0; i < 7 && getline(lines, line); i++) cout << "  " << line << endl;
+    return 0;
+}
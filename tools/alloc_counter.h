@@ -0,0 +1,103 @@
+/**
+ * Allocation Counter (replacement global operator new / delete)
+ *
+ * Problem: Several programs have to prove a claim about the heap, e.g. that
+ * steady-state tree queries allocate nothing (query_context.cpp,
+ * flat_traversals.cpp) or that a sort uses O(1) heap (inplace_mergesort.cpp).
+ * Each of them used to carry its own copy of a counting operator new.
+ *
+ * Approach: One replaceable operator set behind a shared counter
+ * - Every block carries a 16-byte header holding its size, so unsized deletes
+ *   can still take the block's bytes off the live total
+ * - g_alloc.allocations / bytes count every request; live is the number of
+ *   bytes currently allocated and peak its high-water mark since the last
+ *   resetPeak()
+ * - The full replaceable set is replaced (scalar, array, sized, nothrow), so
+ *   every new is released by the matching delete
+ * - Programs that attribute memory more finely (memory_profile.cpp charges
+ *   blocks to per-thread scopes) set alloc_counter::onAllocate / onRelease.
+ *   The hooks see the block's header, whose owner and scope fields are theirs
+ *   to fill in; both are 0 for blocks allocated while no hook was set
+ *
+ * Replacement operators must not be inline, so include this header from
+ * exactly one translation unit per program (every program here is a single
+ * .cpp file).
+ */
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+struct AllocCounter {
+    std::atomic<long long> allocations{0};  // operator new calls
+    std::atomic<long long> bytes{0};        // bytes requested in total
+    std::atomic<long long> live{0};         // bytes allocated and not yet freed
+    std::atomic<long long> peak{0};         // highest live since resetPeak()
+
+    void resetPeak() { peak.store(live.load()); }
+};
+
+inline AllocCounter g_alloc;
+
+namespace alloc_counter {
+
+struct Block {
+    size_t size;
+    uint32_t owner;  // for the hooks, e.g. the allocating thread
+    uint32_t scope;  // for the hooks, e.g. the tracker active at allocation
+};
+
+const size_t HEADER = alignof(std::max_align_t);  // keeps the user block aligned
+static_assert(sizeof(Block) <= HEADER, "the block header must fit in front of the user block");
+
+// Optional, set once before any thread that allocates is started
+inline void (*onAllocate)(Block& block) = nullptr;
+inline void (*onRelease)(const Block& block) = nullptr;
+
+inline void* allocate(size_t size, bool nothrow) {
+    char* raw = static_cast<char*>(std::malloc(size + HEADER));
+    if (!raw) {
+        if (nothrow) return nullptr;
+        throw std::bad_alloc();
+    }
+    Block* block = reinterpret_cast<Block*>(raw);
+    *block = {size, 0, 0};
+
+    g_alloc.allocations.fetch_add(1, std::memory_order_relaxed);
+    g_alloc.bytes.fetch_add(size, std::memory_order_relaxed);
+    long long live = g_alloc.live.fetch_add(size, std::memory_order_relaxed) + size;
+    long long peak = g_alloc.peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_alloc.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    if (onAllocate) onAllocate(*block);
+    return raw + HEADER;
+}
+
+inline void release(void* p) {
+    if (!p) return;
+    char* raw = static_cast<char*>(p) - HEADER;
+    const Block* block = reinterpret_cast<const Block*>(raw);
+    g_alloc.live.fetch_sub(block->size, std::memory_order_relaxed);
+    if (onRelease) onRelease(*block);
+    std::free(raw);
+}
+
+}  // namespace alloc_counter
+
+void* operator new(size_t size) { return alloc_counter::allocate(size, false); }
+void* operator new[](size_t size) { return alloc_counter::allocate(size, false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return alloc_counter::allocate(size, true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return alloc_counter::allocate(size, true); }
+
+void operator delete(void* p) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, size_t) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, size_t) noexcept { alloc_counter::release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { alloc_counter::release(p); }
+
+#endif  // ALLOC_COUNTER_H
@@ -0,0 +1,599 @@
+/**
+ * Memory Profile (heap bytes, allocation count, peak live bytes, stack peak)
+ *
+ * Problem: Containers get sized by guesswork. verticalTraversal builds nested
+ * maps, mergeSort puts VLAs on the stack at every level, and the BFS queries
+ * grow deques, so their memory profiles differ widely and nobody measures them.
+ *
+ * Approach: Counting hooks plus a scoped tracker
+ * - The global operator new / delete come from alloc_counter.h, which
+ *   replaces the whole set (scalar, array, sized, nothrow). Its hooks fill in
+ *   the block header's owner and scope with the allocating thread's tag and
+ *   the id of the innermost tracker that was active at allocation
+ * - ScopedTracker (RAII, nestable, per thread) records bytes allocated,
+ *   allocation count, live bytes and peak live bytes for everything allocated
+ *   while it is alive. A free is charged back only to trackers of the
+ *   allocating thread that were active when the block was allocated; tracker
+ *   ids are per thread, so a block freed on another thread is not charged
+ *   there at all
+ * - CountingAllocator<T> is a pluggable std allocator that charges one
+ *   container to a MemoryStats of its own, e.g. just the BFS queue inside
+ *   zigzagLevelOrder
+ * - Stack use (mergeSort's VLAs, recursion depth) never reaches operator new.
+ *   measure() runs each call on a thread whose stack was first filled with a
+ *   known pattern, then finds the deepest byte that was overwritten
+ * - Every algorithm has a budget in MEMORY_BUDGETS. Exceeding a budget by
+ *   more than BUDGET_SLACK makes the program exit with status 1, so a memory
+ *   regression fails a CI step the same way a failing test does.
+ *   "--update" prints a fresh table to paste in
+ *
+ * Inputs are generated from fixed seeds, so the numbers are reproducible for
+ * a given standard library.
+ *
+ * Usage: ./memory_profile [--update]
+ * Build: g++ -std=c++17 -O2 -pthread memory_profile.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <functional>
+#include <thread>
+#include <random>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "alloc_counter.h"
+using namespace std;
+
+const size_t MEASURE_STACK = 64 << 20;  // stack of the measuring thread
+const double BUDGET_SLACK = 0.10;       // allowed growth over a budget
+
+// ==================== COUNTING HOOKS ====================
+
+struct MemoryStats {
+    uint64_t bytes = 0;        // total requested
+    uint64_t allocations = 0;
+    int64_t live = 0;          // currently allocated
+    int64_t peak = 0;          // max of live
+
+    void allocated(size_t n) {
+        bytes += n;
+        allocations++;
+        live += n;
+        peak = max(peak, live);
+    }
+    void freed(size_t n) { live -= n; }
+};
+
+struct ActiveTracker {
+    MemoryStats* stats;
+    uint32_t id;
+};
+
+// Trackers of this thread, outermost first; ids only ever grow within a thread
+thread_local vector<ActiveTracker>* t_trackers = nullptr;
+thread_local uint32_t t_nextId = 1;
+
+// Distinct per thread, so a free can tell whether this thread's ids apply
+atomic<uint32_t> g_nextThreadTag{1};
+thread_local uint32_t t_threadTag = g_nextThreadTag.fetch_add(1, memory_order_relaxed);
+
+// alloc_counter hooks: block.owner is the allocating thread's tag, block.scope
+// the innermost tracker then (0 = none)
+void chargeAllocation(alloc_counter::Block& block) {
+    if (!t_trackers || t_trackers->empty()) return;
+    block.owner = t_threadTag;
+    block.scope = t_trackers->back().id;
+    for (ActiveTracker& t : *t_trackers) t.stats->allocated(block.size);
+}
+
+void chargeRelease(const alloc_counter::Block& block) {
+    // Trackers of the allocating thread that were already active then counted it
+    if (block.scope && t_trackers && block.owner == t_threadTag)
+        for (ActiveTracker& t : *t_trackers)
+            if (t.id <= block.scope) t.stats->freed(block.size);
+}
+
+// Installed before main, while the program is still single-threaded
+const bool g_hooksInstalled = (alloc_counter::onAllocate = chargeAllocation,
+                               alloc_counter::onRelease = chargeRelease, true);
+
+/**
+ * Records every heap allocation of this thread while in scope
+ */
+class ScopedTracker {
+public:
+    explicit ScopedTracker(MemoryStats& stats) {
+        if (!t_trackers) t_trackers = new vector<ActiveTracker>();  // untracked: no tracker yet
+        t_trackers->reserve(16);
+        t_trackers->push_back({&stats, t_nextId++});
+    }
+    ~ScopedTracker() { t_trackers->pop_back(); }
+    ScopedTracker(const ScopedTracker&) = delete;
+};
+
+/**
+ * std allocator that charges one container to its own MemoryStats
+ */
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    MemoryStats* stats;
+
+    explicit CountingAllocator(MemoryStats* stats) : stats(stats) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : stats(other.stats) {}
+
+    T* allocate(size_t n) {
+        stats->allocated(n * sizeof(T));
+        return allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        stats->freed(n * sizeof(T));
+        allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& o) const { return stats == o.stats; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& o) const { return stats != o.stats; }
+};
+
+// ==================== STACK PEAK ====================
+
+struct Measurement {
+    MemoryStats heap;
+    size_t stackPeak = 0;
+};
+
+struct StackJob {
+    function<void()> fn;
+    Measurement* out;
+};
+
+void* runTracked(void* arg) {
+    StackJob* job = (StackJob*)arg;
+    ScopedTracker tracker(job->out->heap);
+    job->fn();
+    return nullptr;
+}
+
+const uint8_t STACK_PATTERN = 0xA5;
+
+/**
+ * Runs fn on a fresh thread with a painted stack; heap stats come from a
+ * ScopedTracker on that thread, stack peak from the painted area
+ */
+Measurement measure(function<void()> fn) {
+    Measurement m;
+    void* stack = mmap(nullptr, MEASURE_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    memset(stack, STACK_PATTERN, MEASURE_STACK);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, MEASURE_STACK);
+    StackJob job{fn, &m};
+    pthread_t thread;
+    pthread_create(&thread, &attr, runTracked, &job);
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    // The stack grows down: the lowest overwritten byte marks the peak
+    const uint8_t* base = (const uint8_t*)stack;
+    size_t untouched = 0;
+    while (untouched < MEASURE_STACK && base[untouched] == STACK_PATTERN) untouched++;
+    m.stackPeak = MEASURE_STACK - untouched;
+
+    munmap(stack, MEASURE_STACK);
+    return m;
+}
+
+// ==================== ALGORITHMS (unchanged from the problem files) ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    // queueStats, if given, is charged for the BFS queue alone
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root, MemoryStats* queueStats = nullptr) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        MemoryStats unused;
+        using Queue = queue<TreeNode*, deque<TreeNode*, CountingAllocator<TreeNode*>>>;
+        Queue q(deque<TreeNode*, CountingAllocator<TreeNode*>>(CountingAllocator<TreeNode*>(queueStats ? queueStats : &unused)));
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+    vector<int> boundaryTraversal(TreeNode* root) {
+        vector<int> result;
+        if (!root) return result;
+        if (!isLeaf(root)) result.push_back(root->val);
+
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right)
+            if (!isLeaf(curr)) result.push_back(curr->val);
+
+        addLeaves(root, result);
+
+        vector<int> temp;
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left)
+            if (!isLeaf(curr)) temp.push_back(curr->val);
+        for (int i = (int)temp.size() - 1; i >= 0; i--)
+            result.push_back(temp[i]);
+        return result;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL) return 0;
+        int lh = depth(root->left, diameter);
+        int rh = depth(root->right, diameter);
+        diameter = max(diameter, lh + rh);
+        return 1 + max(lh, rh);
+    }
+
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+
+    void addLeaves(TreeNode* root, vector<int>& result) {
+        if (isLeaf(root)) {
+            result.push_back(root->val);
+            return;
+        }
+        if (root->left) addLeaves(root->left, result);
+        if (root->right) addLeaves(root->right, result);
+    }
+};
+
+// ==================== BUDGETS ====================
+
+struct Budget {
+    const char* name;
+    uint64_t bytes, allocations;
+    int64_t peak;
+    size_t stackPeak;
+};
+
+// Measured with GCC 12 / libstdc++ on x86-64 (regenerate with --update)
+const Budget MEMORY_BUDGETS[] = {
+    {"mergeSort n=2^20", 4194304, 1, 4194304, 4198904},
+    {"binarySearch x1000", 0, 0, 0, 4648},
+    {"maxPathSum", 0, 0, 0, 5544},
+    {"diameterOfBinaryTree", 0, 0, 0, 5160},
+    {"rightSideView", 508, 7, 384, 5096},
+    {"zigzagLevelOrder", 1057656, 1122, 268560, 5240},
+    {"verticalTraversal", 10201348, 200050, 3121600, 8168},
+    {"boundaryTraversal", 262200, 20, 196608, 5112},
+};
+
+const Budget* budgetFor(const string& name) {
+    for (const Budget& b : MEMORY_BUDGETS)
+        if (name == b.name) return &b;
+    return nullptr;
+}
+
+bool overBudget(uint64_t value, uint64_t budget) {
+    return value > budget + (uint64_t)(budget * BUDGET_SLACK) + 64;  // +64: tiny budgets of 0
+}
+
+// ==================== MAIN ====================
+
+TreeNode* randomTree(vector<TreeNode>& nodes, int n, mt19937& rng) {
+    nodes.resize(n);
+    for (TreeNode& node : nodes) node = TreeNode((int)(rng() % 2001) - 1000);
+    TreeNode* root = &nodes[0];
+    vector<TreeNode**> slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        *slots[s] = &nodes[i];
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&nodes[i].left);
+        slots.push_back(&nodes[i].right);
+    }
+    return root;
+}
+
+int main(int argc, char* argv[]) {
+    bool update = argc > 1 && string(argv[1]) == "--update";
+    mt19937 rng(43);
+    Solution solution;
+
+    vector<int> data(1 << 20);
+    for (int& x : data) x = (int)rng();
+    vector<int> sortedData = data;
+    sort(sortedData.begin(), sortedData.end());
+    vector<TreeNode> nodes;
+    TreeNode* root = randomTree(nodes, 1 << 16, rng);
+
+    // Test Case 1: one reserve is one allocation of exactly its size
+    cout << "Test Case 1 (vector<int>::reserve(1000)):" << endl;
+    MemoryStats one;
+    {
+        ScopedTracker tracker(one);
+        vector<int> v;
+        v.reserve(1000);
+    }
+    cout << "bytes=" << one.bytes << " allocs=" << one.allocations << " peak=" << one.peak << " live=" << one.live << endl;
+    cout << "Expected: bytes=4000 allocs=1 peak=4000 live=0" << endl;
+    bool ok1 = one.bytes == 4000 && one.allocations == 1 && one.peak == 4000 && one.live == 0;
+    cout << (ok1 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: nested trackers; blocks from before a tracker, or from
+    // another thread's trackers (whose ids may be higher), are not charged to it
+    cout << "Test Case 2 (nested trackers):" << endl;
+    MemoryStats outer, inner, foreignStats;
+    char* foreign = nullptr;
+    thread([&]() {
+        for (int i = 0; i < 8; i++) ScopedTracker raiseIds(foreignStats);
+        ScopedTracker tracker(foreignStats);
+        foreign = new char[70];
+    }).join();
+    {
+        ScopedTracker outerTracker(outer);
+        // volatile keeps the compiler from eliding the new/delete pairs
+        char* volatile early = new char[100];
+        {
+            ScopedTracker innerTracker(inner);
+            char* volatile late = new char[50];
+            delete[] late;
+            char* volatile spare = new (nothrow) char[25];  // nothrow forms are counted too
+            delete[] spare;
+            delete[] early;  // allocated before inner started
+            delete[] foreign;  // allocated under a tracker of another thread
+        }
+    }
+    cout << "outer: bytes=" << outer.bytes << " peak=" << outer.peak << " live=" << outer.live
+         << "   inner: bytes=" << inner.bytes << " peak=" << inner.peak << " live=" << inner.live << endl;
+    cout << "Expected: outer: bytes=175 peak=150 live=0   inner: bytes=75 peak=50 live=0" << endl;
+    bool ok2 = outer.bytes == 175 && outer.peak == 150 && outer.live == 0 &&
+               inner.bytes == 75 && inner.peak == 50 && inner.live == 0;
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: CountingAllocator charges only its own container
+    cout << "Test Case 3 (CountingAllocator):" << endl;
+    MemoryStats mine;
+    {
+        vector<int, CountingAllocator<int>> v{CountingAllocator<int>(&mine)};
+        v.reserve(256);
+        vector<int> other(1000);
+    }
+    cout << "bytes=" << mine.bytes << " allocs=" << mine.allocations << " live=" << mine.live << endl;
+    cout << "Expected: bytes=1024 allocs=1 live=0" << endl;
+    bool ok3 = mine.bytes == 1024 && mine.allocations == 1 && mine.live == 0;
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: stack peak grows with the size of a stack buffer
+    cout << "Test Case 4 (stack peak of a 256 KB stack buffer):" << endl;
+    Measurement small = measure([]() { volatile char buf[1024]; buf[0] = 1; (void)buf[0]; });
+    Measurement large = measure([]() {
+        volatile char buf[256 << 10];
+        for (size_t i = 0; i < sizeof(buf); i += 4096) buf[i] = 1;
+        buf[0] = buf[1];
+    });
+    size_t grown = large.stackPeak - small.stackPeak;
+    cout << "difference=" << grown << " bytes" << endl;
+    bool ok4 = grown >= (256 << 10) - 8192 && grown <= (256 << 10) + 8192;
+    cout << (ok4 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: every algorithm against its budget
+    MemoryStats zigzagQueue;
+    vector<pair<string, function<void()>>> runs = {
+        {"mergeSort n=2^20", [&]() { vector<int> a = data; mergeSort(a.data(), 0, a.size() - 1); }},
+        {"binarySearch x1000", [&]() {
+             volatile int sink = 0;
+             for (int i = 0; i < 1000; i++) sink = sink + binarySearch(sortedData.data(), sortedData.size(), data[i]);
+         }},
+        {"maxPathSum", [&]() { solution.maxPathSum(root); }},
+        {"diameterOfBinaryTree", [&]() { solution.diameterOfBinaryTree(root); }},
+        {"rightSideView", [&]() { solution.rightSideView(root); }},
+        {"zigzagLevelOrder", [&]() { solution.zigzagLevelOrder(root, &zigzagQueue); }},
+        {"verticalTraversal", [&]() { solution.verticalTraversal(root); }},
+        {"boundaryTraversal", [&]() { solution.boundaryTraversal(root); }},
+    };
+
+    cout << "Test Case 5 (memory profile, array 2^20 ints, tree 2^16 nodes):" << endl;
+    cout << left << setw(22) << "  algorithm" << right << setw(14) << "heap bytes" << setw(10) << "allocs"
+         << setw(14) << "peak live" << setw(12) << "stack peak" << "  budget" << endl;
+
+    bool regressed = !(ok1 && ok2 && ok3 && ok4);
+    vector<string> updated;
+    for (auto& run : runs) {
+        Measurement m = measure(run.second);
+        const Budget* b = budgetFor(run.first);
+        vector<string> over;
+        if (b && !update) {
+            if (overBudget(m.heap.bytes, b->bytes)) over.push_back("bytes");
+            if (overBudget(m.heap.allocations, b->allocations)) over.push_back("allocs");
+            if (overBudget(m.heap.peak, b->peak)) over.push_back("peak");
+            if (overBudget(m.stackPeak, b->stackPeak)) over.push_back("stack");
+        }
+        regressed |= !over.empty();
+
+        cout << "  " << left << setw(20) << run.first << right << setw(14) << m.heap.bytes << setw(10)
+             << m.heap.allocations << setw(14) << m.heap.peak << setw(12) << m.stackPeak << "  ";
+        if (!b) cout << "none";
+        else if (over.empty()) cout << "ok ✓";
+        else {
+            cout << "OVER ✗ (";
+            for (size_t i = 0; i < over.size(); i++) cout << (i ? ", " : "") << over[i];
+            cout << ")";
+        }
+        cout << endl;
+
+        updated.push_back("    {\"" + run.first + "\", " + to_string(m.heap.bytes) + ", " +
+                          to_string(m.heap.allocations) + ", " + to_string(m.heap.peak) + ", " +
+                          to_string(m.stackPeak) + "},");
+    }
+
+    cout << "  zigzag BFS queue alone (CountingAllocator): " << zigzagQueue.bytes << " bytes, "
+         << zigzagQueue.allocations << " allocs, peak " << zigzagQueue.peak << endl;
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    cout << "  process peak RSS: " << usage.ru_maxrss / 1024 << " MB" << endl;
+
+    if (update) {
+        cout << endl << "const Budget MEMORY_BUDGETS[] = {" << endl;
+        for (const string& line : updated) cout << line << endl;
+        cout << "};" << endl;
+        return 0;
+    }
+    cout << (regressed ? "FAILED ✗ (memory regression)" : "PASSED ✓") << endl;
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,678 @@
+/**
+ * Huge-Page and NUMA-Aware Placement for Sort Buffers and Tree Arenas
+ *
+ * Problem: A 100M-int mergeSort buffer or a 10^8-node tree allocated by one
+ * thread lands on that thread's NUMA node, and every core on the other socket
+ * then reads it across the interconnect. With 4 KB pages, the TLB also covers
+ * only a tiny part of such an array.
+ *
+ * Approach: Allocation options plus workers pinned to match them
+ * - LargeBuffer<T> is an mmap-backed array configured by AllocOptions:
+ *   - pages: Default (4 KB), Transparent (2 MB-aligned mapping +
+ *     madvise(MADV_HUGEPAGE)), or Explicit (MAP_HUGETLB from the reserved
+ *     pool). Explicit falls back to Transparent when the pool is empty and
+ *     records that in hugeFallback
+ *   - placement: Default (kernel first touch by whoever writes first),
+ *     Interleave (mbind(MPOL_INTERLEAVE) over all nodes, page by page), or
+ *     FirstTouch (the buffer is split into one chunk per worker and each
+ *     pinned worker writes its own chunk first)
+ * - Topology reads /sys/devices/system/node to find each node's CPUs. Worker w
+ *   runs on node w % nodes and is pinned to one CPU of that node, so the
+ *   worker that touched a chunk is the worker that later sorts or traverses it
+ * - parallelMergeSort: each pinned worker sorts its own chunk (node-local
+ *   under FirstTouch), then pairs of chunks are merged by the worker that owns
+ *   the left chunk
+ * - TreeArena lays a balanced tree out in preorder inside one LargeBuffer, so
+ *   the top levels split it into contiguous subtrees. Each worker gets a run
+ *   of consecutive subtrees, and the FirstTouch chunks are cut at exactly
+ *   those ranges. Each worker builds its own subtrees, and parallelMaxPathSum
+ *   later reads them, plus a gain buffer placed the same way, on the same node
+ * - pageNodes() asks move_pages(2) which node holds each page, and
+ *   hugePageBytes() reads AnonHugePages for the mapping from /proc/self/smaps,
+ *   so the tests check the placement that really happened
+ *
+ * Only raw syscalls are used (no libnuma). On a single-node machine every
+ * policy degenerates to node 0 and the code still runs.
+ *
+ * Usage: ./numa_placement [log2 n]   (default 2^24 ints / tree nodes)
+ * Build: g++ -std=c++17 -O2 -pthread numa_placement.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+using namespace std;
+
+const size_t HUGE_PAGE = 2 << 20;
+const size_t SMALL_PAGE = 4096;
+
+// ==================== TOPOLOGY ====================
+
+/**
+ * CPUs of every NUMA node; one node with every CPU if sysfs has no node info
+ */
+struct Topology {
+    vector<vector<int>> nodeCpus;
+
+    static vector<int> parseCpuList(const string& list) {
+        vector<int> cpus;
+        stringstream in(list);
+        string range;
+        while (getline(in, range, ',')) {
+            if (range.empty() || !isdigit((unsigned char)range[0])) continue;
+            size_t dash = range.find('-');
+            int first = stoi(range.substr(0, dash));
+            int last = (dash == string::npos) ? first : stoi(range.substr(dash + 1));
+            for (int c = first; c <= last; c++) cpus.push_back(c);
+        }
+        return cpus;
+    }
+
+    static Topology detect() {
+        Topology t;
+        for (int node = 0; node < 1024; node++) {
+            ifstream in("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+            if (!in) {
+                if (node > 0 && t.nodeCpus.size() > 0) break;
+                continue;
+            }
+            string list;
+            getline(in, list);
+            vector<int> cpus = parseCpuList(list);
+            if (!cpus.empty()) t.nodeCpus.push_back(cpus);
+        }
+        if (t.nodeCpus.empty()) {
+            t.nodeCpus.emplace_back();
+            for (unsigned c = 0; c < max(1u, thread::hardware_concurrency()); c++) t.nodeCpus[0].push_back(c);
+        }
+        return t;
+    }
+
+    int nodes() const { return nodeCpus.size(); }
+
+    // Worker w: node w % nodes, then round-robin over that node's CPUs
+    int nodeOf(unsigned worker) const { return worker % nodes(); }
+    int cpuOf(unsigned worker) const {
+        const vector<int>& cpus = nodeCpus[nodeOf(worker)];
+        return cpus[(worker / nodes()) % cpus.size()];
+    }
+};
+
+bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+/**
+ * Runs fn(w) for w in [0, workers), worker w pinned to topology.cpuOf(w)
+ */
+template <typename Fn>
+void runPinned(const Topology& topology, unsigned workers, Fn fn) {
+    vector<thread> threads;
+    for (unsigned w = 0; w < workers; w++)
+        threads.emplace_back([&, w]() {
+            pinCurrentThread(topology.cpuOf(w));
+            fn(w);
+        });
+    for (auto& t : threads) t.join();
+}
+
+// ==================== LARGE BUFFERS ====================
+
+enum class PageMode { Default, Transparent, Explicit };
+enum class Placement { Default, Interleave, FirstTouch };
+
+const char* pageModeName(PageMode m) {
+    return m == PageMode::Default ? "4K" : m == PageMode::Transparent ? "THP" : "hugetlb";
+}
+const char* placementName(Placement p) {
+    return p == Placement::Default ? "default" : p == Placement::Interleave ? "interleave" : "first-touch";
+}
+
+struct AllocOptions {
+    PageMode pages = PageMode::Default;
+    Placement placement = Placement::Default;
+    unsigned workers = 1;  // FirstTouch: chunks touched by workers 0..workers-1
+};
+
+/**
+ * mmap-backed array of n trivially copyable T, placed per AllocOptions.
+ * Memory is zeroed by its first toucher. Under FirstTouch, worker w touches
+ * [chunks[w], chunks[w + 1]); chunks needs options.workers + 1 ascending
+ * entries ending at n, or can be left empty for equal chunks
+ */
+template <typename T>
+class LargeBuffer {
+public:
+    LargeBuffer() = default;
+
+    LargeBuffer(size_t n, const AllocOptions& options, const Topology& topology, vector<size_t> chunks = {})
+        : count(n), options(options), chunks(move(chunks)) {
+        size_t bytes = max<size_t>(n * sizeof(T), 1);
+        mapped = nullptr;
+
+        if (options.pages == PageMode::Explicit) {
+            length = roundUp(bytes, HUGE_PAGE);
+            void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                mapped = p;
+                base = (T*)p;
+            } else {
+                hugeFallback = true;  // no reserved pool: use THP instead
+            }
+        }
+        if (!mapped) {
+            bool huge = options.pages != PageMode::Default;
+            length = roundUp(bytes, huge ? HUGE_PAGE : SMALL_PAGE) + (huge ? HUGE_PAGE : 0);
+            void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw bad_alloc();
+            mapped = p;
+            // Align the usable range to 2 MB so THP can back it from the first byte
+            uintptr_t start = huge ? roundUp((uintptr_t)p, HUGE_PAGE) : (uintptr_t)p;
+            base = (T*)start;
+            if (huge) madvise(base, roundUp(bytes, HUGE_PAGE), MADV_HUGEPAGE);
+        }
+
+        if (options.placement == Placement::Interleave) interleave(topology);
+        if (options.placement == Placement::FirstTouch) {
+            runPinned(topology, options.workers, [&](unsigned w) {
+                size_t first = chunkBegin(w), last = chunkBegin(w + 1);
+                memset((void*)(base + first), 0, (last - first) * sizeof(T));
+            });
+        }
+    }
+
+    ~LargeBuffer() {
+        if (mapped) munmap(mapped, length);
+    }
+
+    LargeBuffer(LargeBuffer&& other) noexcept { *this = move(other); }
+    LargeBuffer& operator=(LargeBuffer&& other) noexcept {
+        swap(mapped, other.mapped);
+        swap(base, other.base);
+        swap(length, other.length);
+        swap(count, other.count);
+        swap(options, other.options);
+        swap(chunks, other.chunks);
+        swap(hugeFallback, other.hugeFallback);
+        return *this;
+    }
+    LargeBuffer(const LargeBuffer&) = delete;
+
+    T* data() { return base; }
+    const T* data() const { return base; }
+    T& operator[](size_t i) { return base[i]; }
+    const T& operator[](size_t i) const { return base[i]; }
+    size_t size() const { return count; }
+    size_t bytes() const { return count * sizeof(T); }
+
+    // Element range first touched by worker w under FirstTouch
+    size_t chunkBegin(unsigned w) const { return chunks.empty() ? count * w / options.workers : chunks[w]; }
+
+    bool hugeFallback = false;  // Explicit requested but MAP_HUGETLB failed
+
+private:
+    static size_t roundUp(size_t x, size_t to) { return (x + to - 1) / to * to; }
+
+    void interleave(const Topology& topology) {
+        unsigned long mask[16] = {0};
+        for (int node = 0; node < min(topology.nodes(), 16 * 64); node++)
+            mask[node / 64] |= 1UL << (node % 64);
+        size_t len = roundUp(max<size_t>(bytes(), 1), SMALL_PAGE);
+        syscall(SYS_mbind, base, len, MPOL_INTERLEAVE, mask, 16 * 64, 0);
+    }
+
+    void* mapped = nullptr;
+    T* base = nullptr;
+    size_t length = 0, count = 0;
+    AllocOptions options;
+    vector<size_t> chunks;  // FirstTouch chunk starts; empty = equal chunks
+};
+
+bool transparentHugePagesAvailable() {
+    ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    string modes;
+    getline(in, modes);
+    return in && modes.find("[never]") == string::npos;
+}
+
+/**
+ * Pages of [p, p + bytes) per NUMA node (index -1 collects pages not yet
+ * faulted in or not queryable)
+ */
+vector<size_t> pageNodes(const void* p, size_t bytes, int nodes) {
+    vector<size_t> histogram(nodes + 1, 0);
+    const size_t stride = SMALL_PAGE * 64;  // sample every 256 KB
+    vector<void*> pages;
+    for (size_t off = 0; off < bytes; off += stride) pages.push_back((char*)p + off);
+    vector<int> status(pages.size(), -1);
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) {
+        histogram[nodes] = pages.size();
+        return histogram;
+    }
+    for (int s : status) histogram[(s >= 0 && s < nodes) ? s : nodes]++;
+    return histogram;
+}
+
+/**
+ * AnonHugePages of the mapping that contains p, from /proc/self/smaps
+ */
+size_t hugePageBytes(const void* p) {
+    ifstream smaps("/proc/self/smaps");
+    string line;
+    bool inside = false;
+    uintptr_t addr = (uintptr_t)p;
+    while (getline(smaps, line)) {
+        uintptr_t lo, hi;
+        if (sscanf(line.c_str(), "%lx-%lx ", &lo, &hi) == 2 && line.find(':') > line.find(' ')) {
+            inside = lo <= addr && addr < hi;
+            continue;
+        }
+        size_t kb;
+        if (inside && sscanf(line.c_str(), "AnonHugePages: %zu kB", &kb) == 1) return kb * 1024;
+    }
+    return 0;
+}
+
+// ==================== PARALLEL SORT ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+
+        merge(arr, left, mid, right);
+    }
+}
+
+// Merge src[a, b) and src[b, c) into dst[a, c), stable
+void mergeInto(const int* src, int* dst, size_t a, size_t b, size_t c) {
+    size_t i = a, j = b, k = a;
+    while (i < b && j < c) dst[k++] = (src[j] < src[i]) ? src[j++] : src[i++];
+    while (i < b) dst[k++] = src[i++];
+    while (j < c) dst[k++] = src[j++];
+}
+
+const size_t SORT_RUN = 32;  // insertion-sorted before the first merge pass
+
+// Bottom-up merge sort of arr[0, n) using buffer[0, n); the result ends in arr
+void bottomUpSort(int* arr, int* buffer, size_t n) {
+    for (size_t a = 0; a < n; a += SORT_RUN) {
+        size_t b = min(n, a + SORT_RUN);
+        for (size_t i = a + 1; i < b; i++) {
+            int x = arr[i];
+            size_t j = i;
+            for (; j > a && arr[j - 1] > x; j--) arr[j] = arr[j - 1];
+            arr[j] = x;
+        }
+    }
+    int* src = arr;
+    int* dst = buffer;
+    for (size_t width = SORT_RUN; width < n; width *= 2) {
+        for (size_t a = 0; a < n; a += 2 * width)
+            mergeInto(src, dst, a, min(n, a + width), min(n, a + 2 * width));
+        swap(src, dst);
+    }
+    if (src != arr) memcpy(arr, src, n * sizeof(int));
+}
+
+/**
+ * Sorts data in place with `workers` pinned workers. data and buffer should be
+ * allocated with the same AllocOptions (same worker count), so worker w's
+ * chunk is the one it touched first
+ */
+void parallelMergeSort(LargeBuffer<int>& data, LargeBuffer<int>& buffer, unsigned workers, const Topology& topology) {
+    size_t n = data.size();
+    vector<size_t> bounds(workers + 1);
+    for (unsigned w = 0; w <= workers; w++) bounds[w] = n * w / workers;
+
+    runPinned(topology, workers, [&](unsigned w) {
+        size_t first = bounds[w];
+        bottomUpSort(data.data() + first, buffer.data() + first, bounds[w + 1] - first);
+    });
+
+    // Pairwise merges: the owner of the left chunk merges each pair
+    int* src = data.data();
+    int* dst = buffer.data();
+    for (unsigned width = 1; width < workers; width *= 2) {
+        runPinned(topology, workers, [&](unsigned w) {
+            if (w % (2 * width) != 0) return;
+            size_t a = bounds[w], b = bounds[min(workers, w + width)], c = bounds[min(workers, w + 2 * width)];
+            mergeInto(src, dst, a, b, c);
+        });
+        swap(src, dst);
+    }
+    if (src != data.data())
+        runPinned(topology, workers, [&](unsigned w) {
+            memcpy(data.data() + bounds[w], src + bounds[w], (bounds[w + 1] - bounds[w]) * sizeof(int));
+        });
+}
+
+// ==================== TREE ARENA ====================
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+};
+
+/**
+ * Balanced tree in preorder: every subtree is a contiguous index range and
+ * children always follow their parent. The first `splitDepth` levels are the
+ * "top"; the subtrees below them are tasks, in preorder. Worker w owns a run
+ * of consecutive tasks, so its nodes are one contiguous range, and under
+ * FirstTouch that range is exactly the chunk it touched first
+ */
+class TreeArena {
+public:
+    TreeArena(size_t n, const AllocOptions& options, const Topology& topology, uint64_t seed)
+        : options(options), topology(topology) {
+        workers = max(1u, options.workers);
+        while ((1u << splitDepth) < workers) splitDepth++;
+
+        // Plan first (indices only), so the buffer is touched along the task ranges
+        planTop(0, n, 0);
+        chunks.assign(workers + 1, n);
+        chunks[0] = 0;
+        for (unsigned w = 1; w < workers; w++)
+            chunks[w] = taskBegin(w) < tasks.size() ? tasks[taskBegin(w)].first : n;
+        nodes = LargeBuffer<TreeNode>(n, options, topology, chunks);
+
+        // Top levels on the calling thread, each worker's subtrees on that worker
+        for (const Task& t : top) link(t.first, t.last, seed);
+        runPinned(topology, workers, [&](unsigned w) {
+            for (size_t t = taskBegin(w); t < taskBegin(w + 1); t++) build(tasks[t].first, tasks[t].last, seed);
+        });
+    }
+
+    TreeNode* root() { return nodes.size() ? &nodes[0] : nullptr; }
+    size_t size() const { return nodes.size(); }
+
+    /**
+     * maxPathSum with one pinned worker per subtree task; each sweeps its
+     * range backwards (children before parents), then the top is finished
+     * on the calling thread
+     */
+    int parallelMaxPathSum() {
+        if (!nodes.size()) return INT_MIN;
+        // Placed like the nodes, so each worker's gains sit next to its subtrees
+        LargeBuffer<int> gain(nodes.size(), options, topology, chunks);
+        vector<int> best(workers, INT_MIN);
+        runPinned(topology, workers, [&](unsigned w) {
+            for (size_t t = taskBegin(w); t < taskBegin(w + 1); t++)
+                best[w] = max(best[w], sweep(tasks[t].first, tasks[t].last, gain.data()));
+        });
+        int answer = *max_element(best.begin(), best.end());
+        for (size_t i = top.size(); i-- > 0;) answer = max(answer, visit(top[i].first, gain.data()));
+        return answer;
+    }
+
+private:
+    struct Task {
+        size_t first, last;
+    };
+
+    static int value(size_t i, uint64_t seed) {
+        uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ULL ^ seed;
+        x ^= x >> 31;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 29;
+        return (int)(x % 2001) - 1000;
+    }
+
+    // Node `first` roots [first, last); its left subtree is the next half
+    void link(size_t first, size_t last, uint64_t seed) {
+        TreeNode& node = nodes[first];
+        node.val = value(first, seed);
+        size_t rest = last - first - 1, mid = first + 1 + rest / 2;
+        node.left = rest > 0 ? &nodes[first + 1] : nullptr;
+        node.right = rest >= 2 ? &nodes[mid] : nullptr;
+    }
+
+    // Splits [first, last) into top nodes and subtree tasks, both in preorder
+    void planTop(size_t first, size_t last, int depth) {
+        if (first >= last) return;
+        if (depth == splitDepth) {
+            tasks.push_back({first, last});
+            return;
+        }
+        top.push_back({first, last});
+        size_t rest = last - first - 1, mid = first + 1 + rest / 2;
+        planTop(first + 1, rest >= 2 ? mid : last, depth + 1);
+        if (rest >= 2) planTop(mid, last, depth + 1);
+    }
+
+    // First task of worker w: consecutive tasks, split as evenly as possible
+    size_t taskBegin(unsigned w) const { return tasks.size() * w / workers; }
+
+    // Iterative build of a whole subtree range
+    void build(size_t first, size_t last, uint64_t seed) {
+        vector<Task> stack = {{first, last}};
+        while (!stack.empty()) {
+            Task t = stack.back();
+            stack.pop_back();
+            if (t.first >= t.last) continue;
+            link(t.first, t.last, seed);
+            size_t rest = t.last - t.first - 1, mid = t.first + 1 + rest / 2;
+            if (rest >= 2) {
+                stack.push_back({t.first + 1, mid});
+                stack.push_back({mid, t.last});
+            } else {
+                stack.push_back({t.first + 1, t.last});
+            }
+        }
+    }
+
+    int visit(size_t i, int* gain) {
+        TreeNode& node = nodes[i];
+        int l = node.left ? max(0, gain[node.left - &nodes[0]]) : 0;
+        int r = node.right ? max(0, gain[node.right - &nodes[0]]) : 0;
+        gain[i] = node.val + max(l, r);
+        return l + r + node.val;
+    }
+
+    int sweep(size_t first, size_t last, int* gain) {
+        int best = INT_MIN;
+        for (size_t i = last; i-- > first;) best = max(best, visit(i, gain));
+        return best;
+    }
+
+    LargeBuffer<TreeNode> nodes;
+    AllocOptions options;
+    const Topology& topology;
+    unsigned workers = 1;
+    int splitDepth = 0;
+    vector<Task> tasks;    // subtrees below the top, in preorder
+    vector<Task> top;      // top nodes with the end of their subtree, in preorder
+    vector<size_t> chunks; // worker w's nodes: [chunks[w], chunks[w + 1])
+};
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+string histogramText(const vector<size_t>& h) {
+    ostringstream out;
+    for (size_t node = 0; node + 1 < h.size(); node++) out << "node" << node << "=" << h[node] << " ";
+    out << "unknown=" << h.back();
+    return out.str();
+}
+
+int main(int argc, char* argv[]) {
+    int logN = (argc > 1) ? atoi(argv[1]) : 24;
+    size_t n = (size_t)1 << logN;
+    Topology topology = Topology::detect();
+    unsigned workers = max<unsigned>(2, thread::hardware_concurrency());
+
+    // Test Case 1: topology
+    cout << "Test Case 1 (topology):" << endl;
+    size_t cpus = 0;
+    for (int node = 0; node < topology.nodes(); node++) {
+        cout << "  node" << node << ": " << topology.nodeCpus[node].size() << " cpus" << endl;
+        cpus += topology.nodeCpus[node].size();
+    }
+    vector<int> parsed = Topology::parseCpuList("0-3,8,10-11\n");
+    bool ok1 = cpus >= 1 && parsed == vector<int>{0, 1, 2, 3, 8, 10, 11};
+    cout << (ok1 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: every page mode and placement allocates and reports where its
+    // pages went; on several nodes, Interleave must reach every node and each
+    // FirstTouch chunk must be on its worker's node
+    cout << "Test Case 2 (64 MB buffer per option):" << endl;
+    bool ok2 = true;
+    for (PageMode pages : {PageMode::Default, PageMode::Transparent, PageMode::Explicit}) {
+        for (Placement placement : {Placement::Default, Placement::Interleave, Placement::FirstTouch}) {
+            LargeBuffer<int> buffer(16 << 20, {pages, placement, workers}, topology);
+            for (size_t i = 0; i < buffer.size(); i += 1024) buffer[i] = (int)i;  // fault everything in
+            bool aligned = pages == PageMode::Default || (uintptr_t)buffer.data() % HUGE_PAGE == 0;
+            vector<size_t> h = pageNodes(buffer.data(), buffer.bytes(), topology.nodes());
+            size_t huge = hugePageBytes(buffer.data());
+            ok2 &= aligned && buffer[1024] == 1024;
+            if (pages == PageMode::Transparent && transparentHugePagesAvailable()) ok2 &= huge > 0;
+            // With several nodes, the pages must be where the placement put them
+            if (topology.nodes() > 1 && placement == Placement::Interleave)
+                for (int node = 0; node < topology.nodes(); node++) ok2 &= h[node] > 0;
+            if (topology.nodes() > 1 && placement == Placement::FirstTouch) {
+                // Whole pages of each chunk only: a page across a chunk edge goes to one of the two workers
+                uintptr_t page = pages == PageMode::Default ? SMALL_PAGE : HUGE_PAGE;
+                for (unsigned w = 0; w < workers; w++) {
+                    uintptr_t first = ((uintptr_t)(buffer.data() + buffer.chunkBegin(w)) + page - 1) / page * page;
+                    uintptr_t last = (uintptr_t)(buffer.data() + buffer.chunkBegin(w + 1)) / page * page;
+                    if (first >= last) continue;
+                    vector<size_t> chunk = pageNodes((void*)first, last - first, topology.nodes());
+                    size_t sampled = 0;
+                    for (size_t count : chunk) sampled += count;
+                    ok2 &= chunk[topology.nodeOf(w)] == sampled;
+                }
+            }
+            cout << "  " << setw(7) << pageModeName(pages) << setw(12) << placementName(placement) << ": "
+                 << histogramText(h) << ", huge pages " << (huge >> 20) << " MB"
+                 << (buffer.hugeFallback ? " (no hugetlb pool, fell back to THP)" : "") << endl;
+        }
+    }
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: parallel sort under every option vs mergeSort
+    cout << "Test Case 3 (parallel sort vs mergeSort, 2^18 ints):" << endl;
+    mt19937 rng(46);
+    const size_t small = 1 << 18;
+    vector<int> input(small);
+    for (int& x : input) x = (int)rng();
+    vector<int> expected = input;
+    mergeSort(expected.data(), 0, small - 1);
+    bool ok3 = true;
+    for (PageMode pages : {PageMode::Default, PageMode::Transparent})
+        for (Placement placement : {Placement::Default, Placement::Interleave, Placement::FirstTouch})
+            for (unsigned w : {1u, 3u, workers}) {
+                AllocOptions options{pages, placement, w};
+                LargeBuffer<int> data(small, options, topology), buffer(small, options, topology);
+                memcpy(data.data(), input.data(), small * sizeof(int));
+                parallelMergeSort(data, buffer, w, topology);
+                ok3 &= equal(expected.begin(), expected.end(), data.data());
+            }
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: arena tree built by pinned workers vs Solution::maxPathSum
+    cout << "Test Case 4 (tree arena maxPathSum vs Solution):" << endl;
+    Solution solution;
+    bool ok4 = true;
+    for (size_t size : {1, 2, 3, 7, 100, 4097, 100000})
+        for (unsigned w : {1u, 2u, 5u}) {
+            TreeArena tree(size, {PageMode::Transparent, Placement::FirstTouch, w}, topology, size * 31 + w);
+            ok4 &= tree.parallelMaxPathSum() == solution.maxPathSum(tree.root());
+        }
+    cout << (ok4 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: timings on this machine
+    cout << "Test Case 5 (2^" << logN << " ints / nodes, " << workers << " workers, " << topology.nodes()
+         << " NUMA node" << (topology.nodes() > 1 ? "s" : "") << "):" << endl;
+    vector<int> big(n);
+    for (int& x : big) x = (int)rng();
+    for (PageMode pages : {PageMode::Default, PageMode::Transparent})
+        for (Placement placement : {Placement::Default, Placement::Interleave, Placement::FirstTouch}) {
+            AllocOptions options{pages, placement, workers};
+            LargeBuffer<int> data(n, options, topology), buffer(n, options, topology);
+            memcpy(data.data(), big.data(), n * sizeof(int));
+            auto start = chrono::steady_clock::now();
+            parallelMergeSort(data, buffer, workers, topology);
+            double sortMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            TreeArena tree(n, options, topology, 46);
+            start = chrono::steady_clock::now();
+            volatile int sink = tree.parallelMaxPathSum();
+            (void)sink;
+            double treeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            cout << "  " << setw(4) << pageModeName(pages) << setw(12) << placementName(placement) << ": sort "
+                 << fixed << setprecision(1) << setw(7) << sortMs << " ms, tree maxPathSum " << setw(6) << treeMs
+                 << " ms" << endl;
+        }
+    return 0;
+}
@@ -0,0 +1,656 @@
+/**
+ * Trace Events (compile-time trace points, per-thread ring buffers, Chrome JSON)
+ *
+ * Problem: A profiler shows that mergeSort or zigzagLevelOrder is slow, but not
+ * where inside one long call: which recursion level of mergeSort, which BFS
+ * level, or whether verticalTraversal spends its time building the map or the
+ * output.
+ *
+ * Approach: Begin / end events at phase boundaries, recorded cheaply per thread
+ * - TRACE_BEGIN(name, argName, arg) / TRACE_END(name) / TRACE_SCOPE(name)
+ *   expand to nothing unless the build sets TRACING=1 (the default here).
+ *   Build with -DTRACING=0 and the traced functions compile to the original code
+ * - Each thread owns a TraceRing: a fixed power-of-two array of 32-byte events
+ *   and a head counter. Only the owning thread writes, so recording an event
+ *   is an rdtsc, four stores and a release store of the head. No locks and no
+ *   atomic read-modify-write. When the ring is full the oldest events are
+ *   overwritten
+ * - Rings register themselves once per thread and are never freed, so events
+ *   from threads that have exited can still be dumped
+ * - writeChromeTrace() snapshots every ring without stopping the writers. It
+ *   rereads the head after copying and drops any slot that may have been
+ *   overwritten meanwhile, including the one the next event is being written
+ *   to, so a wrapped ring yields its newest capacity - 1 events. It also drops end events whose begin was
+ *   overwritten. Timestamps are converted from TSC ticks to microseconds with
+ *   a rate measured against steady_clock. Load the result in chrome://tracing
+ *   or ui.perfetto.dev
+ * - The trace points stay coarse, to keep the overhead under 2%:
+ *   - mergeSort traces only ranges of at least TRACE_MIN_SPAN elements, with
+ *     "level" = recursion depth, plus their merge step
+ *   - zigzagLevelOrder emits one span per batch of consecutive BFS levels
+ *     holding at least TRACE_MIN_LEVEL nodes, so a long chain of one-node
+ *     levels does not emit an event pair per node. "level" is the first level
+ *     of the batch
+ *   - verticalTraversal emits "vertical.map" (BFS into the nested maps) and
+ *     "vertical.output" (flattening into columns)
+ *
+ * Event names must be string literals (or otherwise outlive the dump), since
+ * only the pointer is stored.
+ *
+ * Time Complexity: O(1) per event, O(total events) per dump
+ * Space Complexity: TRACE_RING_EVENTS * 32 bytes per thread that traced
+ *
+ * Usage: ./trace_events [trace.json]   (tests, overhead report, optional dump)
+ * Build: g++ -std=c++17 -O2 -pthread trace_events.cpp   (-DTRACING=0 to compile out)
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <queue>
+#include <map>
+#include <set>
+#include <string>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+using namespace std;
+
+#ifndef TRACING
+#define TRACING 1
+#endif
+
+const size_t TRACE_RING_EVENTS = 1 << 16;  // per thread, power of two
+const int TRACE_MIN_SPAN = 1 << 14;        // smaller mergeSort ranges are not traced
+const int TRACE_MIN_LEVEL = 1 << 10;       // nodes per zigzag level span
+
+// ==================== RING BUFFERS ====================
+
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct TraceEvent {
+    uint64_t ticks;
+    const char* name;
+    const char* argName;  // nullptr: no argument
+    int32_t arg;
+    char phase;           // 'B' begin, 'E' end
+};
+
+class TraceRing {
+public:
+    explicit TraceRing(uint32_t tid) : tid(tid), events(new TraceEvent[TRACE_RING_EVENTS]) {}
+
+    void record(char phase, const char* name, const char* argName, int32_t arg) {
+        uint64_t h = head.load(memory_order_relaxed);
+        TraceEvent& e = events[h & (TRACE_RING_EVENTS - 1)];
+        e.ticks = readTicks();
+        e.name = name;
+        e.argName = argName;
+        e.arg = arg;
+        e.phase = phase;
+        head.store(h + 1, memory_order_release);
+    }
+
+    /** The surviving events, oldest first. Safe while the owner keeps writing */
+    vector<TraceEvent> snapshot() const {
+        uint64_t end = head.load(memory_order_acquire);
+        uint64_t begin = end > TRACE_RING_EVENTS ? end - TRACE_RING_EVENTS : 0;
+        vector<TraceEvent> out;
+        out.reserve(end - begin);
+        for (uint64_t i = begin; i < end; i++) out.push_back(events[i & (TRACE_RING_EVENTS - 1)]);
+        // Slots below the new head - capacity may have been rewritten while
+        // copying, and so may the next one: record() fills event `after`'s slot
+        // before it publishes the head
+        uint64_t after = head.load(memory_order_acquire);
+        uint64_t stale = after + 1 > TRACE_RING_EVENTS ? after + 1 - TRACE_RING_EVENTS : 0;
+        if (stale > begin) out.erase(out.begin(), out.begin() + min<uint64_t>(stale - begin, out.size()));
+        return out;
+    }
+
+    uint64_t recorded() const { return head.load(memory_order_acquire); }
+
+    const uint32_t tid;
+
+private:
+    unique_ptr<TraceEvent[]> events;
+    atomic<uint64_t> head{0};
+};
+
+class TraceRegistry {
+public:
+    static TraceRegistry& instance() {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    /** The calling thread's ring, created on its first event */
+    TraceRing& ring() {
+        thread_local TraceRing* mine = nullptr;
+        if (!mine) {
+            lock_guard<mutex> lock(guard);
+            rings.emplace_back(new TraceRing((uint32_t)rings.size() + 1));
+            mine = rings.back().get();
+        }
+        return *mine;
+    }
+
+    vector<const TraceRing*> all() {
+        lock_guard<mutex> lock(guard);
+        vector<const TraceRing*> out;
+        for (auto& r : rings) out.push_back(r.get());
+        return out;
+    }
+
+    /** TSC ticks per microsecond, measured from registry creation to now */
+    double ticksPerMicrosecond() {
+        auto elapsed = chrono::steady_clock::now() - startTime;
+        if (elapsed < chrono::milliseconds(10)) this_thread::sleep_for(chrono::milliseconds(10) - elapsed);
+        uint64_t ticks = readTicks() - startTicks;
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - startTime).count();
+        return ticks / us;
+    }
+
+private:
+    TraceRegistry() : startTicks(readTicks()), startTime(chrono::steady_clock::now()) {}
+
+    mutex guard;  // taken once per thread and by dumps, never per event
+    vector<unique_ptr<TraceRing>> rings;
+    uint64_t startTicks;
+    chrono::steady_clock::time_point startTime;
+};
+
+inline void traceEvent(char phase, const char* name, const char* argName = nullptr, int32_t arg = 0) {
+    TraceRegistry::instance().ring().record(phase, name, argName, arg);
+}
+
+struct TraceScope {
+    const char* name;
+    explicit TraceScope(const char* name) : name(name) { traceEvent('B', name); }
+    ~TraceScope() { traceEvent('E', name); }
+};
+
+#if TRACING
+#define TRACE_BEGIN(name, argName, arg) traceEvent('B', name, argName, arg)
+#define TRACE_END(name) traceEvent('E', name)
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_BEGIN(name, argName, arg) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+// ==================== CHROME TRACE EXPORT ====================
+
+void writeJsonString(ostream& out, const char* s) {
+    out << '"';
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') out << '\\' << *s;
+        else if ((unsigned char)*s < 0x20) out << ' ';
+        else out << *s;
+    }
+    out << '"';
+}
+
+/**
+ * Writes every ring as Chrome trace event JSON. Returns the number of events
+ * written
+ */
+size_t writeChromeTrace(ostream& out) {
+    TraceRegistry& registry = TraceRegistry::instance();
+    double ticksPerUs = registry.ticksPerMicrosecond();
+
+    vector<pair<uint32_t, vector<TraceEvent>>> threads;
+    uint64_t epoch = UINT64_MAX;
+    for (const TraceRing* ring : registry.all()) {
+        threads.push_back({ring->tid, ring->snapshot()});
+        if (!threads.back().second.empty()) epoch = min(epoch, threads.back().second.front().ticks);
+    }
+
+    size_t written = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char ts[32];
+    for (auto& thread : threads) {
+        int depth = 0;
+        for (const TraceEvent& e : thread.second) {
+            if (e.phase == 'E' && depth == 0) continue;  // its begin was overwritten
+            depth += e.phase == 'B' ? 1 : -1;
+            snprintf(ts, sizeof ts, "%.3f", (e.ticks - epoch) / ticksPerUs);
+            out << (written++ ? ",\n" : "\n") << "{\"name\":";
+            writeJsonString(out, e.name);
+            out << ",\"ph\":\"" << e.phase << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << thread.first;
+            if (e.argName) {
+                out << ",\"args\":{";
+                writeJsonString(out, e.argName);
+                out << ":" << e.arg << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return written;
+}
+
+// ==================== ORIGINAL ALGORITHMS ====================
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+        merge(arr, left, mid, right);
+    }
+}
+
+class Solution {
+public:
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+};
+
+// ==================== TRACED ALGORITHMS ====================
+
+void tracedMergeSort(int arr[], int left, int right, int level = 0) {
+    if (left < right) {
+        bool traced = right - left + 1 >= TRACE_MIN_SPAN;
+        if (traced) TRACE_BEGIN("mergeSort", "level", level);
+        int mid = left + (right - left) / 2;
+        tracedMergeSort(arr, left, mid, level + 1);
+        tracedMergeSort(arr, mid + 1, right, level + 1);
+        if (traced) TRACE_BEGIN("merge", "level", level);
+        merge(arr, left, mid, right);
+        if (traced) {
+            TRACE_END("merge");
+            TRACE_END("mergeSort");
+        }
+    }
+}
+
+class TracedSolution {
+public:
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        TRACE_SCOPE("zigzagLevelOrder");
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+        int batched = 0;  // nodes in the open "zigzag.levels" span, 0: none open
+
+        while (!q.empty()) {
+            int size = q.size();
+            if (batched == 0) TRACE_BEGIN("zigzag.levels", "level", (int)result.size());
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+            batched += size;
+            if (batched >= TRACE_MIN_LEVEL || q.empty()) {
+                TRACE_END("zigzag.levels");
+                batched = 0;
+            }
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        TRACE_SCOPE("verticalTraversal");
+        if (!root) return {};
+
+        TRACE_BEGIN("vertical.map", nullptr, 0);
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+        TRACE_END("vertical.map");
+
+        TRACE_BEGIN("vertical.output", nullptr, 0);
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        TRACE_END("vertical.output");
+        return answer;
+    }
+};
+
+// ==================== UTILITY FUNCTIONS FOR TESTING ====================
+
+TreeNode* randomTree(vector<TreeNode>& nodes, int n, mt19937& rng) {
+    nodes.resize(n);
+    for (TreeNode& node : nodes) node = TreeNode((int)(rng() % 2001) - 1000);
+    TreeNode* root = &nodes[0];
+    vector<TreeNode**> slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        *slots[s] = &nodes[i];
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&nodes[i].left);
+        slots.push_back(&nodes[i].right);
+    }
+    return root;
+}
+
+/** Every end closes the innermost open begin of the same name, none left open */
+bool balanced(const vector<TraceEvent>& events) {
+    vector<const char*> open;
+    for (const TraceEvent& e : events) {
+        if (e.phase == 'B') {
+            open.push_back(e.name);
+        } else {
+            if (open.empty() || string(open.back()) != e.name) return false;
+            open.pop_back();
+        }
+    }
+    return open.empty();
+}
+
+const TraceRing& currentRing() { return TraceRegistry::instance().ring(); }
+
+/** Events this thread recorded since `from` (its ring must not have wrapped) */
+vector<TraceEvent> eventsSince(uint64_t from) {
+    vector<TraceEvent> all = currentRing().snapshot();
+    uint64_t end = currentRing().recorded();
+    return vector<TraceEvent>(all.end() - (end - from), all.end());
+}
+
+double elapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/** Fastest of `reps` runs of each, in ms. Runs alternate so drift hits both alike */
+template <typename Plain, typename Traced>
+pair<double, double> fastestPair(int reps, Plain plain, Traced traced) {
+    double best[2] = {1e300, 1e300};
+    for (int r = 0; r < reps; r++) {
+        auto start = chrono::steady_clock::now();
+        plain();
+        best[0] = min(best[0], elapsedMs(start));
+        start = chrono::steady_clock::now();
+        traced();
+        best[1] = min(best[1], elapsedMs(start));
+    }
+    return {best[0], best[1]};
+}
+
+// ==================== MAIN ====================
+
+int main(int argc, char* argv[]) {
+    mt19937 rng(50);
+    Solution plain;
+    TracedSolution traced;
+    bool ok;
+
+    vector<int> data(1 << 19);  // merge's VLAs stay well inside the default stack
+    for (int& x : data) x = (int)rng();
+    vector<TreeNode> nodes;
+    TreeNode* root = randomTree(nodes, 1 << 18, rng);
+
+    // Test Case 1: traced functions return the same results as the originals
+    cout << "Test Case 1 (traced == original results):" << endl;
+    vector<int> a = data, b = data;
+    mergeSort(a.data(), 0, (int)a.size() - 1);
+    uint64_t mark = currentRing().recorded();
+    tracedMergeSort(b.data(), 0, (int)b.size() - 1);
+    vector<TraceEvent> sortEvents = eventsSince(mark);
+    ok = a == b && plain.zigzagLevelOrder(root) == traced.zigzagLevelOrder(root) &&
+         plain.verticalTraversal(root) == traced.verticalTraversal(root);
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: the expected spans, properly nested
+    cout << "Test Case 2 (span structure):" << endl;
+#if TRACING
+    // Ranges >= 2^14 of a 2^19 sort: levels 0..5, 2^6 - 1 ranges, each with a merge
+    size_t mergeSorts = count_if(sortEvents.begin(), sortEvents.end(), [](const TraceEvent& e) {
+        return e.phase == 'B' && string(e.name) == "mergeSort";
+    });
+    int deepest = 0;
+    for (const TraceEvent& e : sortEvents) deepest = max(deepest, e.arg);
+    mark = currentRing().recorded();
+    traced.verticalTraversal(root);
+    vector<string> verticalNames;
+    for (const TraceEvent& e : eventsSince(mark)) verticalNames.push_back(string(1, e.phase) + e.name);
+    cout << "mergeSort spans: " << mergeSorts << " deepest level: " << deepest << endl;
+    cout << "Expected: mergeSort spans: 63 deepest level: 5" << endl;
+    ok = mergeSorts == 63 && deepest == 5 && balanced(sortEvents) &&
+         sortEvents.size() == 4 * mergeSorts &&
+         verticalNames == vector<string>{"BverticalTraversal", "Bvertical.map", "Evertical.map",
+                                         "Bvertical.output", "Evertical.output", "EverticalTraversal"};
+
+    // A chain of 5000 one-node levels: batched into ceil(5000 / 1024) = 5 spans
+    vector<TreeNode> chain(5000);
+    for (size_t i = 0; i + 1 < chain.size(); i++) chain[i].right = &chain[i + 1];
+    mark = currentRing().recorded();
+    traced.zigzagLevelOrder(&chain[0]);
+    vector<TraceEvent> chainEvents = eventsSince(mark);
+    cout << "chain of 5000 levels: " << chainEvents.size() << " events" << endl;
+    cout << "Expected: chain of 5000 levels: 12 events" << endl;
+    ok &= chainEvents.size() == 12 && balanced(chainEvents) && chainEvents[1].arg == 0 &&
+          chainEvents[3].arg == 1024 && chainEvents[9].arg == 4096;
+#else
+    ok = sortEvents.empty();
+    cout << "TRACING=0: no events recorded" << endl;
+#endif
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: a wrapped ring keeps its newest events, minus the slot the
+    // next record() would overwrite
+    cout << "Test Case 3 (ring wraps, " << TRACE_RING_EVENTS << " events):" << endl;
+    TraceRing ring(99);
+    for (int i = 0; i < 3 * (int)TRACE_RING_EVENTS + 5; i++) ring.record(i % 2 ? 'E' : 'B', "x", "i", i);
+    vector<TraceEvent> kept = ring.snapshot();
+    ok = kept.size() == TRACE_RING_EVENTS - 1 && kept.front().arg == 2 * (int)TRACE_RING_EVENTS + 6 &&
+         kept.back().arg == 3 * (int)TRACE_RING_EVENTS + 4;
+    for (size_t i = 1; i < kept.size() && ok; i++) ok = kept[i].arg == kept[i - 1].arg + 1 && kept[i].ticks >= kept[i - 1].ticks;
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: several threads, one ring each, dumped as Chrome JSON
+    cout << "Test Case 4 (3 threads, Chrome trace JSON):" << endl;
+    vector<thread> workers;
+    for (int t = 0; t < 3; t++) {
+        workers.emplace_back([&] {
+            TracedSolution local;
+            local.zigzagLevelOrder(root);
+            vector<int> copy(data.begin(), data.begin() + (1 << 16));
+            tracedMergeSort(copy.data(), 0, (int)copy.size() - 1);
+        });
+    }
+    for (auto& w : workers) w.join();
+    ostringstream json;
+    size_t written = writeChromeTrace(json);
+    string text = json.str();
+    size_t rings = TraceRegistry::instance().all().size();
+    bool threadsBalanced = true;
+    for (const TraceRing* r : TraceRegistry::instance().all()) threadsBalanced &= balanced(r->snapshot());
+    cout << "rings: " << rings << " events written: " << written << " JSON bytes: " << text.size() << endl;
+    ok = threadsBalanced && count(text.begin(), text.end(), '{') == count(text.begin(), text.end(), '}') &&
+         text.rfind("\n]}\n") == text.size() - 4;
+#if TRACING
+    ok &= rings == 4 && written > 0 && text.find("\"tid\":4") != string::npos;
+#else
+    ok &= written == 0;
+#endif
+    if (argc > 1) {
+        ofstream file(argv[1]);
+        writeChromeTrace(file);
+        cout << "trace written to " << argv[1] << (file ? "" : " (write failed)") << endl;
+        ok &= bool(file);
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: overhead of the trace points against the original code.
+    // Wall-clock differences of a few percent are within run-to-run noise, so
+    // the budget is checked on events per call * cost per event / call time
+    cout << "Test Case 5 (overhead):" << endl;
+    const int calibration = 1 << 19;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < calibration; i++) {
+        traceEvent('B', "calibrate");
+        traceEvent('E', "calibrate");
+    }
+    double nsPerEvent = elapsedMs(start) * 1e6 / (2.0 * calibration);
+    cout << "cost per event: " << nsPerEvent << " ns" << endl;
+
+    const int reps = 7;
+    vector<pair<double, double>> times = {
+        fastestPair(reps, [&] { a = data; mergeSort(a.data(), 0, (int)a.size() - 1); },
+                    [&] { b = data; tracedMergeSort(b.data(), 0, (int)b.size() - 1); }),
+        fastestPair(reps, [&] { plain.zigzagLevelOrder(root); }, [&] { traced.zigzagLevelOrder(root); }),
+        fastestPair(reps, [&] { plain.verticalTraversal(root); }, [&] { traced.verticalTraversal(root); }),
+    };
+    vector<function<void()>> calls = {
+        [&] { b = data; tracedMergeSort(b.data(), 0, (int)b.size() - 1); },
+        [&] { traced.zigzagLevelOrder(root); },
+        [&] { traced.verticalTraversal(root); },
+    };
+    const char* names[3] = {"mergeSort 2^19", "zigzagLevelOrder 2^18", "verticalTraversal 2^18"};
+    double worst = 0;
+    for (int i = 0; i < 3; i++) {
+        mark = currentRing().recorded();
+        calls[i]();
+        uint64_t events = currentRing().recorded() - mark;
+        double overhead = 100 * events * nsPerEvent / (times[i].first * 1e6);
+        worst = max(worst, overhead);
+        cout << names[i] << ": " << events << " events, " << overhead << "% overhead (measured "
+             << times[i].first << " ms -> " << times[i].second << " ms)" << endl;
+    }
+    cout << "worst overhead: " << worst << "% (budget 2%)" << endl;
+#if TRACING
+    ok = worst < 2;
+#else
+    ok = worst == 0;
+#endif
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    return 0;
+}
@@ -0,0 +1,620 @@
+/**
+ * Balanced BST Bulk Build (sorted array -> contiguous tree / Eytzinger index)
+ *
+ * Problem: After mergeSort has sorted the keys, we want to run the tree
+ * analytics (verticalTraversal, boundaryTraversal, the side views) on a
+ * balanced BST of them. Inserting the keys one by one into a balanced tree
+ * costs O(N log N) and scatters the nodes across the heap.
+ *
+ * Approach: Place every node directly, since its position is known in advance
+ * - BstLayout::Preorder: the subtree over sorted[lo, hi) has its root
+ *   sorted[mid] (mid = lo + (hi - lo) / 2) at block index `at`, the left
+ *   subtree at at + 1 and the right subtree at at + 1 + (mid - lo). Each node
+ *   is written once, so the build is O(N). The block is in preorder, like
+ *   tree_relayout.cpp's Layout::Preorder, so a DFS reads it almost sequentially
+ * - BstLayout::Eytzinger: the implicit heap layout. Node k (1-based) has
+ *   children 2k and 2k + 1, and an in-order walk of that shape hands out the
+ *   sorted keys. The subtree under k takes a contiguous range of sorted[], and
+ *   its size comes from the heap shape alone. The keys also go into a plain int
+ *   array, so contains / lowerBound become a branchless descent
+ *   k = 2k + (keys[k] < target) that prefetches four levels ahead
+ * - Parallel by recursive halves: the two subtrees of a node cover disjoint
+ *   input and output ranges. The first ceil(log2 threads) levels hand their
+ *   left subtree to a new thread and build the right one themselves
+ * - The result is a BulkBst. Its root() is an ordinary TreeNode*, so every
+ *   Solution query runs on it unchanged
+ *
+ * Both layouts have the minimum height, floor(log2 N) + 1.
+ *
+ * Time Complexity: O(N / threads + log N) build, O(log N) contains / lowerBound
+ * Space Complexity: O(N) nodes (+ N + 1 ints for the Eytzinger index)
+ *
+ * Usage: ./bst_bulk_build [keys] [threads]   (default 2^22 keys)
+ * Build: g++ -std=c++17 -O2 -pthread bst_bulk_build.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <set>
+#include <queue>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== REFERENCE SOLUTION ====================
+
+class Solution {
+public:
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+    vector<int> boundaryTraversal(TreeNode* root) {
+        vector<int> result;
+        if (!root) return result;
+        if (!isLeaf(root)) result.push_back(root->val);
+
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right)
+            if (!isLeaf(curr)) result.push_back(curr->val);
+
+        addLeaves(root, result);
+
+        vector<int> temp;
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left)
+            if (!isLeaf(curr)) temp.push_back(curr->val);
+        for (int i = (int)temp.size() - 1; i >= 0; i--)
+            result.push_back(temp[i]);
+        return result;
+    }
+
+private:
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+
+    void addLeaves(TreeNode* root, vector<int>& result) {
+        if (isLeaf(root)) {
+            result.push_back(root->val);
+            return;
+        }
+        if (root->left) addLeaves(root->left, result);
+        if (root->right) addLeaves(root->right, result);
+    }
+};
+
+// ==================== BULK BUILD ====================
+
+enum class BstLayout { Preorder, Eytzinger };
+
+/** Number of nodes under node k in a heap-shaped tree of n nodes */
+size_t heapSubtreeSize(size_t k, size_t n) {
+    size_t size = 0;
+    for (size_t lo = k, hi = k; lo <= n; lo = 2 * lo, hi = 2 * hi + 1)
+        size += min(hi, n) - lo + 1;
+    return size;
+}
+
+/** Recursion levels that fork a thread: 2^levels >= threads */
+int spawnLevels(unsigned threads) {
+    int levels = 0;
+    while ((1u << levels) < threads) levels++;
+    return levels;
+}
+
+class BulkBst {
+public:
+    BulkBst() = default;
+    BulkBst(BulkBst&&) = default;
+    BulkBst& operator=(BulkBst&&) = default;
+    BulkBst(const BulkBst&) = delete;  // copies would point into the old block
+
+    TreeNode* root() { return nodes.empty() ? nullptr : &nodes[0]; }
+    size_t size() const { return nodes.size(); }
+    BstLayout layout() const { return shape; }
+    const TreeNode* block() const { return nodes.data(); }
+
+    /** Smallest key >= target, or nullptr if every key is smaller */
+    const int* lowerBound(int target) const {
+        if (shape == BstLayout::Preorder) {
+            const TreeNode* node = nodes.empty() ? nullptr : &nodes[0];
+            const int* best = nullptr;
+            while (node) {
+                if (node->val >= target) {
+                    best = &node->val;
+                    node = node->left;
+                } else {
+                    node = node->right;
+                }
+            }
+            return best;
+        }
+
+        size_t n = nodes.size(), k = 1;
+        const int* base = keys.data();
+        while (k <= n) {
+            __builtin_prefetch(base + 16 * k);  // four levels down; never faults
+            k = 2 * k + (base[k] < target);
+        }
+        // The answer is where the last left turn was taken: drop the trailing
+        // right turns (1 bits) and that left turn
+        k >>= __builtin_ffsll(~k);
+        return k ? base + k : nullptr;
+    }
+
+    bool contains(int target) const {
+        const int* key = lowerBound(target);
+        return key && *key == target;
+    }
+
+private:
+    vector<TreeNode> nodes;  // contiguous; nodes[0] is the root
+    vector<int> keys;        // Eytzinger only: keys[k] is node k, keys[0] unused
+    BstLayout shape = BstLayout::Preorder;
+
+    /** Builds sorted[lo, hi) into nodes[at, at + hi - lo) in preorder */
+    void buildPreorder(const int sorted[], size_t lo, size_t hi, size_t at, int forks) {
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            TreeNode& node = nodes[at];
+            node.val = sorted[mid];
+            node.left = mid > lo ? &nodes[at + 1] : nullptr;
+            node.right = hi > mid + 1 ? &nodes[at + 1 + (mid - lo)] : nullptr;
+
+            if (forks > 0) {
+                thread left(&BulkBst::buildPreorder, this, sorted, lo, mid, at + 1, forks - 1);
+                buildPreorder(sorted, mid + 1, hi, at + 1 + (mid - lo), forks - 1);
+                left.join();
+                return;
+            }
+            // Recurse into the smaller-or-equal left half, loop on the right
+            buildPreorder(sorted, lo, mid, at + 1, 0);
+            at += 1 + (mid - lo);
+            lo = mid + 1;
+        }
+    }
+
+    /** In-order fill of the heap subtree under k; returns the next unused input index */
+    size_t fillEytzinger(const int sorted[], size_t k, size_t next) {
+        size_t n = nodes.size();
+        if (k > n) return next;
+        next = fillEytzinger(sorted, 2 * k, next);
+        keys[k] = sorted[next++];
+        return fillEytzinger(sorted, 2 * k + 1, next);
+    }
+
+    /** Fills the subtree under k from sorted[offset...], forking for the top levels */
+    void fillEytzingerParallel(const int sorted[], size_t k, size_t offset, int forks) {
+        size_t n = nodes.size();
+        if (k > n) return;
+        if (forks == 0) {
+            fillEytzinger(sorted, k, offset);
+            return;
+        }
+        size_t leftSize = heapSubtreeSize(2 * k, n);
+        keys[k] = sorted[offset + leftSize];
+        thread left(&BulkBst::fillEytzingerParallel, this, sorted, 2 * k, offset, forks - 1);
+        fillEytzingerParallel(sorted, 2 * k + 1, offset + leftSize + 1, forks - 1);
+        left.join();
+    }
+
+    void linkEytzinger(unsigned threads) {
+        size_t n = nodes.size();
+        vector<thread> workers;
+        auto link = [&](size_t from, size_t to) {
+            for (size_t k = from; k < to; k++) {
+                TreeNode& node = nodes[k - 1];
+                node.val = keys[k];
+                node.left = 2 * k <= n ? &nodes[2 * k - 1] : nullptr;
+                node.right = 2 * k + 1 <= n ? &nodes[2 * k] : nullptr;
+            }
+        };
+        size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 1; t < threads && t * chunk < n; t++)
+            workers.emplace_back(link, 1 + t * chunk, 1 + min(n, (t + 1) * chunk));
+        link(1, 1 + min(n, chunk));
+        for (auto& w : workers) w.join();
+    }
+
+    friend BulkBst buildBalancedBst(const int sorted[], int n, BstLayout layout, unsigned threads);
+};
+
+/**
+ * Builds a minimum-height BST over sorted[0, n) (ascending, duplicates allowed)
+ * without comparing any keys. threads = 1 builds on the calling thread
+ */
+BulkBst buildBalancedBst(const int sorted[], int n, BstLayout layout, unsigned threads = 1) {
+    BulkBst tree;
+    tree.shape = layout;
+    if (n <= 0) return tree;
+    threads = max(1u, threads);
+    tree.nodes.resize(n);
+
+    if (layout == BstLayout::Preorder) {
+        tree.buildPreorder(sorted, 0, n, 0, spawnLevels(threads));
+    } else {
+        tree.keys.resize((size_t)n + 1);
+        tree.keys[0] = INT_MIN;
+        tree.fillEytzingerParallel(sorted, 1, 0, spawnLevels(threads));
+        tree.linkEytzinger(threads);
+    }
+    return tree;
+}
+
+// ==================== ORIGINAL ARRAY ROUTINES ====================
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int L[n1], R[n2];
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+
+    while (i < n1)
+        arr[k++] = L[i++];
+
+    while (j < n2)
+        arr[k++] = R[j++];
+}
+
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+        merge(arr, left, mid, right);
+    }
+}
+
+int binarySearch(int arr[], int n, int target) {
+    int left = 0, right = n - 1;
+
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+
+        if (arr[mid] == target)
+            return mid;
+        else if (arr[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    return -1;
+}
+
+// ==================== UTILITY FUNCTIONS FOR TESTING ====================
+
+/** The usual pointer-per-node build, same middle choice as BstLayout::Preorder */
+TreeNode* sortedArrayToBST(const int sorted[], int lo, int hi) {
+    if (lo >= hi) return nullptr;
+    int mid = lo + (hi - lo) / 2;
+    return new TreeNode(sorted[mid], sortedArrayToBST(sorted, lo, mid),
+                        sortedArrayToBST(sorted, mid + 1, hi));
+}
+
+void deleteTree(TreeNode* root) {
+    vector<TreeNode*> stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+        if (node->left) stack.push_back(node->left);
+        if (node->right) stack.push_back(node->right);
+        delete node;
+    }
+}
+
+vector<int> inorder(TreeNode* root) {
+    vector<int> out;
+    vector<TreeNode*> stack;
+    for (TreeNode* node = root; node || !stack.empty();) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        out.push_back(node->val);
+        node = node->right;
+    }
+    return out;
+}
+
+int treeHeight(TreeNode* root) {
+    vector<TreeNode*> level;
+    if (root) level.push_back(root);
+    int h = 0;
+    while (!level.empty()) {
+        vector<TreeNode*> next;
+        for (TreeNode* node : level) {
+            if (node->left) next.push_back(node->left);
+            if (node->right) next.push_back(node->right);
+        }
+        level.swap(next);
+        h++;
+    }
+    return h;
+}
+
+int minimumHeight(size_t n) {
+    int h = 0;
+    while (n) {
+        n >>= 1;
+        h++;
+    }
+    return h;
+}
+
+/** Every node is reached exactly once and every link points into the block */
+bool linksInsideBlock(BulkBst& tree) {
+    const TreeNode* first = tree.block();
+    const TreeNode* last = first + tree.size();
+    vector<char> seen(tree.size(), 0);
+    vector<TreeNode*> stack;
+    if (tree.root()) stack.push_back(tree.root());
+    size_t visited = 0;
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+        if (node < first || node >= last || seen[node - first]++) return false;
+        visited++;
+        if (node->left) stack.push_back(node->left);
+        if (node->right) stack.push_back(node->right);
+    }
+    return visited == tree.size();
+}
+
+bool sameBlock(BulkBst& a, BulkBst& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        const TreeNode& x = a.block()[i];
+        const TreeNode& y = b.block()[i];
+        if (x.val != y.val || (x.left ? x.left - a.block() : -1) != (y.left ? y.left - b.block() : -1) ||
+            (x.right ? x.right - a.block() : -1) != (y.right ? y.right - b.block() : -1))
+            return false;
+    }
+    return true;
+}
+
+void printLevels(const vector<vector<int>>& levels) {
+    cout << "[";
+    for (size_t i = 0; i < levels.size(); i++) {
+        cout << "[";
+        for (size_t j = 0; j < levels[i].size(); j++)
+            cout << levels[i][j] << (j + 1 < levels[i].size() ? "," : "");
+        cout << "]" << (i + 1 < levels.size() ? "," : "");
+    }
+    cout << "]";
+}
+
+vector<vector<int>> levelOrder(TreeNode* root) {
+    vector<vector<int>> levels = Solution().zigzagLevelOrder(root);
+    for (size_t i = 1; i < levels.size(); i += 2) reverse(levels[i].begin(), levels[i].end());
+    return levels;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main(int argc, char* argv[]) {
+    int bigN = (argc > 1) ? atoi(argv[1]) : 1 << 22;
+    unsigned threads = (argc > 2) ? atoi(argv[2]) : max(2u, thread::hardware_concurrency());
+    Solution solution;
+    mt19937 rng(49);
+
+    // Test Case 1: [-10,-3,0,5,9] in both layouts
+    // Preorder picks the middle key at every level: 0 / -3 9 / -10 5
+    // Eytzinger fills the heap shape in order: 5 / -3 9 / -10 0
+    cout << "Test Case 1:" << endl;
+    int small[] = {-10, -3, 0, 5, 9};
+    BulkBst pre = buildBalancedBst(small, 5, BstLayout::Preorder);
+    BulkBst eyt = buildBalancedBst(small, 5, BstLayout::Eytzinger);
+    cout << "Preorder levels: ";
+    printLevels(levelOrder(pre.root()));
+    cout << endl << "Expected: [[0],[-3,9],[-10,5]]" << endl;
+    cout << "Eytzinger levels: ";
+    printLevels(levelOrder(eyt.root()));
+    cout << endl << "Expected: [[5],[-3,9],[-10,0]]" << endl;
+    bool ok = levelOrder(pre.root()) == vector<vector<int>>{{0}, {-3, 9}, {-10, 5}} &&
+              levelOrder(eyt.root()) == vector<vector<int>>{{5}, {-3, 9}, {-10, 0}} &&
+              eyt.contains(0) && !eyt.contains(1) && *eyt.lowerBound(1) == 5 && !eyt.lowerBound(10) &&
+              *pre.lowerBound(-11) == -10 && !pre.lowerBound(10);
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 2: empty input and a single key
+    cout << "Test Case 2 (empty, single key):" << endl;
+    ok = true;
+    for (BstLayout layout : {BstLayout::Preorder, BstLayout::Eytzinger}) {
+        BulkBst none = buildBalancedBst(small, 0, layout, 4);
+        BulkBst one = buildBalancedBst(small + 2, 1, layout, 4);
+        ok &= !none.root() && !none.contains(0) && !none.lowerBound(INT_MIN);
+        ok &= one.size() == 1 && one.root()->val == 0 && !one.root()->left && !one.root()->right;
+        ok &= one.contains(0) && !one.contains(1) && *one.lowerBound(INT_MIN) == 0;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: mergeSort output, duplicates, 1-5 threads, both layouts
+    cout << "Test Case 3 (400 random arrays, mergeSort -> bulk build, vs pointer build):" << endl;
+    ok = true;
+    for (int trial = 0; trial < 400 && ok; trial++) {
+        int n = rng() % 300;
+        vector<int> keys(n);
+        for (int& k : keys) k = (int)(rng() % 200) - 100;
+        if (n > 0) mergeSort(keys.data(), 0, n - 1);
+
+        TreeNode* reference = sortedArrayToBST(keys.data(), 0, n);
+        for (BstLayout layout : {BstLayout::Preorder, BstLayout::Eytzinger}) {
+            BulkBst serial = buildBalancedBst(keys.data(), n, layout, 1);
+            ok &= inorder(serial.root()) == keys;
+            ok &= treeHeight(serial.root()) == minimumHeight(n);
+            ok &= linksInsideBlock(serial);
+            for (unsigned t = 2; t <= 5; t++) {
+                BulkBst parallel = buildBalancedBst(keys.data(), n, layout, t);
+                ok &= sameBlock(serial, parallel);
+            }
+            if (layout == BstLayout::Preorder) {
+                // Same shape as the pointer build, so every query agrees
+                ok &= solution.verticalTraversal(serial.root()) == solution.verticalTraversal(reference);
+                ok &= solution.boundaryTraversal(serial.root()) == solution.boundaryTraversal(reference);
+                ok &= solution.rightSideView(serial.root()) == solution.rightSideView(reference);
+                ok &= solution.zigzagLevelOrder(serial.root()) == solution.zigzagLevelOrder(reference);
+            }
+            for (int q = -102; q <= 102; q++) {
+                auto it = lower_bound(keys.begin(), keys.end(), q);
+                const int* found = serial.lowerBound(q);
+                ok &= (it == keys.end()) ? !found : (found && *found == *it);
+                ok &= serial.contains(q) == (binarySearch(keys.data(), n, q) != -1);
+            }
+        }
+        deleteTree(reference);
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: a large build, repeated inserts vs bulk build, then queries
+    cout << "Test Case 4 (" << bigN << " keys, " << threads << " threads):" << endl;
+    vector<int> sorted(bigN);
+    for (int i = 0; i < bigN; i++) sorted[i] = 2 * i;  // sorted, with gaps for misses
+
+    auto start = chrono::steady_clock::now();
+    set<int> inserted;
+    for (int k : sorted) inserted.insert(k);
+    double setMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    TreeNode* pointers = sortedArrayToBST(sorted.data(), 0, bigN);
+    double pointerMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    double buildMs[2][2];
+    ok = true;
+    BulkBst built[2];
+    for (int l = 0; l < 2; l++) {
+        BstLayout layout = l ? BstLayout::Eytzinger : BstLayout::Preorder;
+        for (int t = 0; t < 2; t++) {
+            start = chrono::steady_clock::now();
+            built[l] = buildBalancedBst(sorted.data(), bigN, layout, t ? threads : 1);
+            buildMs[l][t] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+        ok &= inorder(built[l].root()) == sorted && treeHeight(built[l].root()) == minimumHeight(bigN);
+    }
+    cout << "set inserts: " << setMs << " ms, new per node: " << pointerMs << " ms" << endl;
+    cout << "bulk preorder: " << buildMs[0][0] << " ms (1 thread), " << buildMs[0][1] << " ms ("
+         << threads << " threads)" << endl;
+    cout << "bulk eytzinger: " << buildMs[1][0] << " ms (1 thread), " << buildMs[1][1] << " ms ("
+         << threads << " threads)" << endl;
+
+    start = chrono::steady_clock::now();
+    ok &= solution.boundaryTraversal(built[0].root()) == solution.boundaryTraversal(pointers);
+    ok &= solution.rightSideView(built[0].root()) == solution.rightSideView(pointers);
+    double blockQueryMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "boundary + right side view, block vs pointer tree: " << blockQueryMs << " ms" << endl;
+    deleteTree(pointers);
+
+    const int queries = 1 << 21;
+    vector<int> probes(queries);
+    for (int& p : probes) p = (int)(rng() % (2u * bigN));
+    long long hits[3] = {0, 0, 0};
+    double searchMs[3];
+    start = chrono::steady_clock::now();
+    for (int p : probes) hits[0] += binarySearch(sorted.data(), bigN, p) != -1;
+    searchMs[0] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    for (int l = 0; l < 2; l++) {
+        start = chrono::steady_clock::now();
+        for (int p : probes) hits[l + 1] += built[l].contains(p);
+        searchMs[l + 1] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    ok &= hits[0] == hits[1] && hits[0] == hits[2];
+    cout << queries << " lookups: binarySearch " << searchMs[0] << " ms, preorder tree " << searchMs[1]
+         << " ms, eytzinger " << searchMs[2] << " ms (" << hits[0] << " hits)" << endl;
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    return 0;
+}
@@ -0,0 +1,792 @@
+/**
+ * Randomized Differential Tests for the Tree Solutions
+ *
+ * Problem: Optimized tree query variants must return exactly what the
+ * reference Solution methods return, on every tree shape and at every size.
+ * Three hand-built sample trees do not cover skewed chains, duplicate values
+ * at the same coordinates or trees with millions of nodes.
+ *
+ * Approach: Generate, diff, shrink
+ * - Generators build trees of a given size and shape: left / right skewed,
+ *   zigzag chain, complete, random BST, random shape, adversarial duplicates
+ *   (values from {0, 1}, many ties in verticalTraversal) and all-negative
+ *   values (maxPathSum). Sizes scale up to 10^7 nodes.
+ * - Every query of each candidate is compared with the reference Solution
+ *   (maxPathSum, diameterOfBinaryTree, rightSideView, zigzagLevelOrder,
+ *   verticalTraversal, boundaryTraversal).
+ * - A failing tree is shrunk: prune subtrees, hoist a child into its parent's
+ *   place, and halve values, keeping each change only while the failure
+ *   persists. The minimal tree is printed in level-order.
+ *
+ * Trees are generated as index-based FlatTrees (easy to mutate while
+ * shrinking) and converted to each candidate's own TreeNode type per run.
+ *
+ * Candidates are the real variant files, not copies: each .cpp is included
+ * into a namespace of its own (see VARIANTS UNDER TEST), so their TreeNode,
+ * Solution and main() do not collide, and a change to a variant is tested as
+ * soon as it is made. To cover a new variant, include its file the same way
+ * and add a check to candidates().
+ *
+ * Usage: ./differential_test [maxN] [seed]     (default maxN = 100000)
+ * Build: g++ -std=c++17 -O2 -pthread differential_test.cpp
+ *
+ * Note: the reference solutions are recursive, so skewed trees need a stack
+ * proportional to their height; the tests run on a thread with a large stack.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <array>
+#include <string>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "../../tools/alloc_counter.h"
+using namespace std;
+
+// ==================== VARIANTS UNDER TEST ====================
+// Every standard header the variants use is included above, so the include
+// guards keep them out of these namespaces; only the variants' own code lands
+// inside.
+
+namespace query_context {
+#include "query_context.cpp"
+}
+
+namespace forest_batch {
+#include "forest_batch.cpp"
+}
+
+namespace tree_relayout {
+#include "tree_relayout.cpp"
+}
+
+namespace implicit_tree_views {
+#include "../medium/implicit_tree_views.cpp"
+}
+
+namespace flat_traversals {
+#include "flat_traversals.cpp"
+}
+
+namespace tree_ingest {
+#include "tree_ingest.cpp"
+}
+
+namespace parallel_vertical {
+#include "parallel_vertical.cpp"
+}
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== REFERENCE SOLUTIONS (unchanged algorithms) ====================
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+    vector<int> boundaryTraversal(TreeNode* root) {
+        vector<int> result;
+        if (!root) return result;
+        if (!isLeaf(root)) result.push_back(root->val);
+
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right)
+            if (!isLeaf(curr)) result.push_back(curr->val);
+
+        addLeaves(root, result);
+
+        vector<int> temp;
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left)
+            if (!isLeaf(curr)) temp.push_back(curr->val);
+        for (int i = (int)temp.size() - 1; i >= 0; i--)
+            result.push_back(temp[i]);
+        return result;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL) return 0;
+        int lh = depth(root->left, diameter);
+        int rh = depth(root->right, diameter);
+        diameter = max(diameter, lh + rh);
+        return 1 + max(lh, rh);
+    }
+
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+
+    void addLeaves(TreeNode* root, vector<int>& result) {
+        if (isLeaf(root)) {
+            result.push_back(root->val);
+            return;
+        }
+        if (root->left) addLeaves(root->left, result);
+        if (root->right) addLeaves(root->right, result);
+    }
+};
+
+// ==================== FLAT TREES + GENERATORS ====================
+
+/**
+ * Index-based tree: node i has value val[i] and children left[i] / right[i]
+ * (-1 for none). Unreachable entries are ignored.
+ */
+struct FlatTree {
+    vector<int> val, left, right;
+    int root = -1;
+
+    int add(int v) {
+        val.push_back(v);
+        left.push_back(-1);
+        right.push_back(-1);
+        return val.size() - 1;
+    }
+};
+
+struct Generator {
+    string name;
+    function<FlatTree(int n, mt19937& rng)> make;
+};
+
+// Chain where each step goes left with probability pLeft
+FlatTree chain(int n, mt19937& rng, int pLeftPercent) {
+    FlatTree t;
+    if (n == 0) return t;
+    int prev = t.root = t.add(rng() % 201 - 100);
+    for (int i = 1; i < n; i++) {
+        int node = t.add(rng() % 201 - 100);
+        if ((int)(rng() % 100) < pLeftPercent) t.left[prev] = node;
+        else t.right[prev] = node;
+        prev = node;
+    }
+    return t;
+}
+
+// Random shape: attach each new node to a random free slot of an existing node
+FlatTree randomShape(int n, mt19937& rng, function<int()> value) {
+    FlatTree t;
+    if (n == 0) return t;
+    t.root = t.add(value());
+    while ((int)t.val.size() < n) {
+        int parent = rng() % t.val.size();
+        vector<int>& side = (rng() % 2) ? t.left : t.right;
+        if (side[parent] >= 0) continue;
+        int node = t.add(value());
+        side[parent] = node;
+    }
+    return t;
+}
+
+vector<Generator> generators() {
+    return {
+        {"left skewed", [](int n, mt19937& rng) { return chain(n, rng, 100); }},
+        {"right skewed", [](int n, mt19937& rng) { return chain(n, rng, 0); }},
+        {"zigzag chain", [](int n, mt19937& rng) { return chain(n, rng, 50); }},
+        {"complete", [](int n, mt19937& rng) {
+            FlatTree t;
+            for (int i = 0; i < n; i++) t.add(rng() % 201 - 100);
+            for (int i = 0; i < n; i++) {
+                if (2 * i + 1 < n) t.left[i] = 2 * i + 1;
+                if (2 * i + 2 < n) t.right[i] = 2 * i + 2;
+            }
+            t.root = n ? 0 : -1;
+            return t;
+        }},
+        {"random BST", [](int n, mt19937& rng) {
+            FlatTree t;
+            for (int i = 0; i < n; i++) {
+                int key = rng() % (4 * n + 1);
+                int node = t.add(key);
+                if (t.root < 0) { t.root = node; continue; }
+                // Iterative insert (duplicates go right)
+                for (int cur = t.root;;) {
+                    vector<int>& side = (key < t.val[cur]) ? t.left : t.right;
+                    if (side[cur] < 0) { side[cur] = node; break; }
+                    cur = side[cur];
+                }
+            }
+            return t;
+        }},
+        {"random shape", [](int n, mt19937& rng) {
+            return randomShape(n, rng, [&]() { return (int)(rng() % 2001) - 1000; });
+        }},
+        {"adversarial duplicates", [](int n, mt19937& rng) {
+            return randomShape(n, rng, [&]() { return (int)(rng() % 2); });
+        }},
+        {"all negative", [](int n, mt19937& rng) {
+            return randomShape(n, rng, [&]() { return -1 - (int)(rng() % 1000); });
+        }},
+    };
+}
+
+// ==================== CANDIDATES ====================
+
+/**
+ * Query results of one implementation on one tree. A candidate fills in the
+ * queries it implements; unset ones are not compared
+ */
+struct Results {
+    optional<int> maxPathSum, diameter;
+    optional<vector<int>> rightSideView, boundaryTraversal;
+    optional<vector<vector<int>>> zigzagLevelOrder, verticalTraversal;
+};
+
+struct TreeCheck {
+    string name;
+    function<Results(const FlatTree&)> run;
+};
+
+/**
+ * Builds a FlatTree as pointer nodes of any TreeNode type (BFS, no recursion)
+ */
+template <typename Node>
+Node* toTreeNodes(const FlatTree& t) {
+    if (t.root < 0) return nullptr;
+    Node* root = new Node(t.val[t.root]);
+    vector<pair<int, Node*>> todo = {{t.root, root}};
+    for (size_t head = 0; head < todo.size(); head++) {
+        int i = todo[head].first;
+        Node* node = todo[head].second;
+        if (t.left[i] >= 0) {
+            node->left = new Node(t.val[t.left[i]]);
+            todo.push_back({t.left[i], node->left});
+        }
+        if (t.right[i] >= 0) {
+            node->right = new Node(t.val[t.right[i]]);
+            todo.push_back({t.right[i], node->right});
+        }
+    }
+    return root;
+}
+
+/**
+ * Deletes a tree of any TreeNode type (iterative, trees can be deep)
+ */
+template <typename Node>
+void deleteTree(Node* root) {
+    vector<Node*> st;
+    if (root) st.push_back(root);
+    while (!st.empty()) {
+        Node* node = st.back();
+        st.pop_back();
+        if (node->left) st.push_back(node->left);
+        if (node->right) st.push_back(node->right);
+        delete node;
+    }
+}
+
+Results reference(const FlatTree& t) {
+    TreeNode* root = toTreeNodes<TreeNode>(t);
+    Solution ref;
+    Results r;
+    if (root) r.maxPathSum = ref.maxPathSum(root);  // undefined for an empty tree
+    r.diameter = ref.diameterOfBinaryTree(root);
+    r.rightSideView = ref.rightSideView(root);
+    r.zigzagLevelOrder = ref.zigzagLevelOrder(root);
+    r.verticalTraversal = ref.verticalTraversal(root);
+    r.boundaryTraversal = ref.boundaryTraversal(root);
+    deleteTree(root);
+    return r;
+}
+
+/** Name of the first query where got disagrees with expected, "" if none */
+string firstMismatch(const Results& expected, const Results& got) {
+    if (got.maxPathSum && expected.maxPathSum && got.maxPathSum != expected.maxPathSum) return "maxPathSum";
+    if (got.diameter && got.diameter != expected.diameter) return "diameterOfBinaryTree";
+    if (got.rightSideView && got.rightSideView != expected.rightSideView) return "rightSideView";
+    if (got.zigzagLevelOrder && got.zigzagLevelOrder != expected.zigzagLevelOrder) return "zigzagLevelOrder";
+    if (got.verticalTraversal && got.verticalTraversal != expected.verticalTraversal) return "verticalTraversal";
+    if (got.boundaryTraversal && got.boundaryTraversal != expected.boundaryTraversal) return "boundaryTraversal";
+    return "";
+}
+
+/**
+ * Values in BFS order if t is a complete tree (no node after the first gap)
+ */
+bool completeHeap(const FlatTree& t, vector<int>& heap) {
+    vector<int> level = {t.root};
+    bool gap = false;
+    for (size_t i = 0; i < level.size(); i++) {
+        int node = level[i];
+        if (node < 0) {
+            gap = true;
+            continue;
+        }
+        if (gap) return false;
+        heap.push_back(t.val[node]);
+        level.push_back(t.left[node]);
+        level.push_back(t.right[node]);
+    }
+    return true;
+}
+
+vector<TreeCheck> candidates() {
+    vector<TreeCheck> checks;
+
+    // query_context.cpp: ContextSolution on the calling thread's QueryContext
+    checks.push_back({"ContextSolution", [](const FlatTree& t) {
+        using Node = query_context::TreeNode;
+        Node* root = toTreeNodes<Node>(t);
+        query_context::ContextSolution sol;
+        query_context::QueryContext& ctx = query_context::threadContext();
+        Results r;
+        if (root) r.maxPathSum = sol.maxPathSum(root, ctx);
+        r.diameter = sol.diameterOfBinaryTree(root, ctx);
+        r.rightSideView = sol.rightSideView(root, ctx);
+        r.zigzagLevelOrder = sol.zigzagLevelOrder(root, ctx).toVector();
+        r.verticalTraversal = sol.verticalTraversal(root, ctx).toVector();
+        r.boundaryTraversal = sol.boundaryTraversal(root, ctx);
+        deleteTree(root);
+        return r;
+    }});
+
+    // forest_batch.cpp: the tree sits between an empty tree and a single node,
+    // so its arena offsets are not zero, and every thread count gets a chunk
+    for (unsigned threads : {1u, 3u}) {
+        checks.push_back({"Forest batch (" + to_string(threads) + " threads)", [threads](const FlatTree& t) {
+            using Node = forest_batch::TreeNode;
+            Node* root = toTreeNodes<Node>(t);
+            Node single(7);
+            forest_batch::Forest forest;
+            forest.addTree(nullptr);
+            forest.addTree(root);
+            forest.addTree(&single);
+            Results r;
+            r.diameter = forest_batch::batchDiameter(forest, threads)[1];
+            if (root) r.maxPathSum = forest_batch::batchMaxPathSum(forest, threads)[1];
+            deleteTree(root);
+            return r;
+        }});
+    }
+
+    // tree_relayout.cpp: the unchanged algorithms on each contiguous copy
+    for (tree_relayout::Layout layout :
+         {tree_relayout::Layout::Preorder, tree_relayout::Layout::BFS, tree_relayout::Layout::VanEmdeBoas}) {
+        checks.push_back({"relayout (" + tree_relayout::layoutName(layout) + ")", [layout](const FlatTree& t) {
+            using Node = tree_relayout::TreeNode;
+            Node* original = toTreeNodes<Node>(t);
+            tree_relayout::RelaidTree tree = tree_relayout::relayout(original, layout);
+            deleteTree(original);
+
+            tree_relayout::Solution sol;
+            Results r;
+            if (tree.root()) r.maxPathSum = sol.maxPathSum(tree.root());
+            r.diameter = sol.diameterOfBinaryTree(tree.root());
+            r.zigzagLevelOrder = sol.zigzagLevelOrder(tree.root());
+            return r;
+        }});
+    }
+
+    // flat_traversals.cpp: one FlatSolution and FlatRows for the whole run, so
+    // buffers left over from a larger tree are reused, as in steady state
+    checks.push_back({"FlatSolution", [](const FlatTree& t) {
+        static flat_traversals::FlatSolution sol;
+        static flat_traversals::FlatRows rows;
+        using Node = flat_traversals::TreeNode;
+        Node* root = toTreeNodes<Node>(t);
+        Results r;
+        sol.zigzagLevelOrder(root, rows);
+        r.zigzagLevelOrder = rows.toVector();
+        sol.verticalTraversal(root, rows);
+        r.verticalTraversal = rows.toVector();
+        deleteTree(root);
+        return r;
+    }});
+
+    // parallel_vertical.cpp: sharded verticalTraversal at several thread counts
+    for (unsigned threads : {1u, 3u, 7u}) {
+        string label = "ParallelVertical (" + to_string(threads) + (threads > 1 ? " threads)" : " thread)");
+        checks.push_back({label, [threads](const FlatTree& t) {
+            using Node = parallel_vertical::TreeNode;
+            Node* root = toTreeNodes<Node>(t);
+            Results r;
+            r.verticalTraversal = parallel_vertical::ParallelVertical(threads).verticalTraversal(root);
+            deleteTree(root);
+            return r;
+        }});
+    }
+
+    // tree_ingest.cpp: serialize, parse back (text with 64-byte reads, so tokens
+    // straddle chunks, and binary), then run all six queries on what was parsed
+    for (bool binary : {false, true}) {
+        checks.push_back({binary ? "ingest (binary)" : "ingest (text)", [binary](const FlatTree& t) {
+            using Node = tree_ingest::TreeNode;
+            Node* original = toTreeNodes<Node>(t);
+            FILE* f = tmpfile();
+            tree_ingest::serialize(original, binary ? nullptr : f, binary ? f : nullptr);
+            rewind(f);
+            deleteTree(original);
+
+            tree_ingest::NodeArena arena;
+            tree_ingest::IngestStats stats;
+            Node* root = binary ? tree_ingest::parseBinary(f, arena, stats, 64)
+                                : tree_ingest::parseLevelOrder(f, arena, stats, 64);
+            fclose(f);
+
+            tree_ingest::Solution sol;
+            Results r;
+            if (!stats.error.empty()) {
+                r.diameter = -1;  // no diameter is negative, so a parse error is a mismatch
+                return r;
+            }
+            if (root) r.maxPathSum = sol.maxPathSum(root);
+            r.diameter = sol.diameterOfBinaryTree(root);
+            r.rightSideView = sol.rightSideView(root);
+            r.zigzagLevelOrder = sol.zigzagLevelOrder(root);
+            r.verticalTraversal = sol.verticalTraversal(root);
+            r.boundaryTraversal = sol.boundaryTraversal(root);
+            return r;
+        }});
+    }
+
+    // implicit_tree_views.cpp: only complete trees have a heap layout; other
+    // shapes return no results, so shrinking stays among complete trees
+    checks.push_back({"implicit heap views", [](const FlatTree& t) {
+        vector<int> heap;
+        if (!completeHeap(t, heap)) return Results{};
+        Results r;
+        r.zigzagLevelOrder = implicit_tree_views::zigzagLevelOrder(heap.data(), heap.size());
+        r.rightSideView = implicit_tree_views::rightSideView(heap.data(), heap.size());
+        return r;
+    }});
+
+    return checks;
+}
+
+// ==================== SHRINK ====================
+
+// Keep only nodes reachable from the root, renumbered in BFS order
+FlatTree compact(const FlatTree& t) {
+    FlatTree out;
+    if (t.root < 0) return out;
+    vector<pair<int, int>> todo = {{t.root, out.add(t.val[t.root])}};
+    out.root = 0;
+    for (size_t head = 0; head < todo.size(); head++) {
+        int oldId = todo[head].first, newId = todo[head].second;
+        if (t.left[oldId] >= 0) {
+            int c = out.add(t.val[t.left[oldId]]);
+            out.left[newId] = c;
+            todo.push_back({t.left[oldId], c});
+        }
+        if (t.right[oldId] >= 0) {
+            int c = out.add(t.val[t.right[oldId]]);
+            out.right[newId] = c;
+            todo.push_back({t.right[oldId], c});
+        }
+    }
+    return out;
+}
+
+/**
+ * Shrink a failing tree while `fails` still returns true.
+ * Mutations are tried in BFS order, so whole subtrees go first.
+ */
+FlatTree shrink(FlatTree tree, const function<bool(const FlatTree&)>& fails) {
+    tree = compact(tree);
+    bool progress = true;
+
+    while (progress) {
+        progress = false;
+
+        // Every child link, as (parent, side)
+        for (size_t i = 0; i < tree.val.size() && !progress; i++) {
+            for (int side = 0; side < 2 && !progress; side++) {
+                int& link = side ? tree.right[i] : tree.left[i];
+                int child = link;
+                if (child < 0) continue;
+
+                // Prune the whole subtree, or hoist one grandchild into its place
+                vector<int> replacements = {-1};
+                if (tree.left[child] >= 0) replacements.push_back(tree.left[child]);
+                if (tree.right[child] >= 0) replacements.push_back(tree.right[child]);
+
+                for (int replacement : replacements) {
+                    FlatTree candidate = tree;
+                    (side ? candidate.right[i] : candidate.left[i]) = replacement;
+                    candidate = compact(candidate);
+                    if (fails(candidate)) {
+                        tree = candidate;
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Hoist a child into the root position
+        for (int child : {tree.root < 0 ? -1 : tree.left[tree.root], tree.root < 0 ? -1 : tree.right[tree.root]}) {
+            if (progress || child < 0) continue;
+            FlatTree candidate = tree;
+            candidate.root = child;
+            candidate = compact(candidate);
+            if (fails(candidate)) {
+                tree = candidate;
+                progress = true;
+            }
+        }
+
+        // Pull values toward 0
+        for (size_t i = 0; i < tree.val.size() && !progress; i++) {
+            if (tree.val[i] == 0) continue;
+            FlatTree candidate = tree;
+            candidate.val[i] /= 2;
+            if (fails(candidate)) {
+                tree = candidate;
+                progress = true;
+            }
+        }
+    }
+    return tree;
+}
+
+// Utility function to print a FlatTree in LeetCode level-order form
+void printTree(const FlatTree& t) {
+    vector<string> out;
+    vector<int> todo = {t.root};
+    for (size_t head = 0; head < todo.size(); head++) {
+        int i = todo[head];
+        if (i < 0) { out.push_back("null"); continue; }
+        out.push_back(to_string(t.val[i]));
+        todo.push_back(t.left[i]);
+        todo.push_back(t.right[i]);
+    }
+    while (!out.empty() && out.back() == "null") out.pop_back();
+
+    cout << "[";
+    for (size_t i = 0; i < out.size(); i++) {
+        cout << out[i];
+        if (i + 1 < out.size()) cout << ",";
+    }
+    cout << "]";
+}
+
+string checkMismatch(const TreeCheck& check, const FlatTree& t) {
+    return firstMismatch(reference(t), check.run(t));
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+struct Options {
+    int maxN;
+    unsigned seed;
+};
+
+int failures = 0;
+
+void* runAll(void* arg) {
+    Options opt = *(Options*)arg;
+
+    vector<int> sizes = {0, 1, 2, 3, 4, 5, 6, 7, 8, 15, 16, 31, 100};
+    for (long long n = 1000; n <= opt.maxN; n *= 10)
+        sizes.push_back(n);
+    if (sizes.back() != opt.maxN && opt.maxN > 100)
+        sizes.push_back(opt.maxN);
+
+    cout << "Test Case 1: candidates vs reference Solution" << endl;
+    vector<TreeCheck> checks = candidates();
+    for (const Generator& g : generators()) {
+        for (int n : sizes) {
+            mt19937 rng(opt.seed + n);
+            FlatTree tree = g.make(n, rng);
+            Results expected = reference(tree);
+
+            for (const TreeCheck& check : checks) {
+                string query = firstMismatch(expected, check.run(tree));
+                if (query.empty()) continue;
+
+                failures++;
+                auto fails = [&](const FlatTree& t) { return checkMismatch(check, t) == query; };
+                cout << "  FAILED ✗ " << check.name << "::" << query << " on " << g.name << " n=" << n << endl;
+                cout << "    shrunk tree: ";
+                printTree(shrink(tree, fails));
+                cout << endl;
+            }
+        }
+        cout << "  " << g.name << " checked" << endl;
+    }
+    cout << endl;
+
+    // Test Case 2: the shrinker itself, on a deliberately broken diameter
+    // that ignores paths not passing through the root
+    cout << "Test Case 2: shrinker self-check (broken candidate)" << endl;
+    TreeCheck broken = {"broken", [](const FlatTree& t) {
+        auto height = [&](int node) {
+            int h = 0;
+            for (vector<int> level = {node}; node >= 0 && !level.empty(); h++) {
+                vector<int> next;
+                for (int x : level) {
+                    if (t.left[x] >= 0) next.push_back(t.left[x]);
+                    if (t.right[x] >= 0) next.push_back(t.right[x]);
+                }
+                level.swap(next);
+            }
+            return h;
+        };
+        Results r;
+        r.diameter = t.root < 0 ? 0 : height(t.left[t.root]) + height(t.right[t.root]);
+        return r;
+    }};
+    mt19937 rng(opt.seed);
+    FlatTree big = generators()[5].make(1000, rng);  // "random shape"
+    FlatTree minimal = compact(shrink(big, [&](const FlatTree& t) { return !checkMismatch(broken, t).empty(); }));
+    cout << "  Shrunk from " << big.val.size() << " to " << minimal.val.size() << " nodes: ";
+    printTree(minimal);
+    cout << endl << "  Expected: 6 nodes, root with one child whose two subtrees both have height 2" << endl;
+
+    // The smallest tree with a diameter that avoids the root: a root above one
+    // node whose subtrees are both 2 deep. It must still fail, and nothing smaller may
+    int child = minimal.root < 0 ? -1 : max(minimal.left[minimal.root], minimal.right[minimal.root]);
+    bool shrunkOk = minimal.val.size() == 6 && !checkMismatch(broken, minimal).empty() &&
+                    (minimal.left[minimal.root] < 0 || minimal.right[minimal.root] < 0) && child >= 0 &&
+                    minimal.left[child] >= 0 && minimal.right[child] >= 0;
+    if (!shrunkOk) failures++;
+    cout << "  " << (shrunkOk ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt = {100000, 12345};
+    if (argc > 1) opt.maxN = min(atoi(argv[1]), 10000000);
+    if (argc > 2) opt.seed = strtoul(argv[2], nullptr, 10);
+
+    cout << "=== Tree Differential Tests (maxN=" << opt.maxN << ", seed=" << opt.seed << ") ===" << endl << endl;
+
+    // Recursive references on a skewed tree need stack proportional to n
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)opt.maxN * 128 + (64 << 20));
+    pthread_t worker;
+    pthread_create(&worker, &attr, runAll, &opt);
+    pthread_join(worker, nullptr);
+    pthread_attr_destroy(&attr);
+
+    if (failures == 0)
+        cout << "=== All Differential Tests PASSED ✓ ===" << endl;
+    else
+        cout << "=== " << failures << " Differential Test(s) FAILED ✗ ===" << endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,340 @@
+/**
+ * Flat (CSR) Output for zigzagLevelOrder and verticalTraversal
+ *
+ * Problem: zigzagLevelOrder returns vector<vector<int>>. That costs one heap
+ * allocation per level, and result.push_back(level) copies each level instead
+ * of moving it. verticalTraversal adds a map of maps of multisets on top.
+ *
+ * Approach: One values array plus one offsets array (CSR layout)
+ * - FlatRows stores every row back to back in `values`; row r is
+ *   values[offsets[r], offsets[r + 1]). offsets always starts with 0
+ * - The BFS frontier is one reusable vector. Each level is a range
+ *   [levelBegin, levelEnd) of it, and children are appended after that
+ *   range. No queue and no per-level vectors
+ * - zigzagLevelOrder writes each value straight to its final slot (forward or
+ *   mirrored inside its level) in a single pass
+ * - verticalTraversal collects (column, row, value) records in the same
+ *   frontier pass, sorts them once, and starts a new output row whenever
+ *   the column changes. Sorting by (column, row, value) gives the same order
+ *   as map<column, map<row, multiset>>
+ * - FlatSolution owns the scratch buffers and FlatRows is owned by the caller.
+ *   Both are only cleared, never shrunk, so repeated calls stop allocating
+ *   once the buffers have grown to the largest tree seen
+ *
+ * Time Complexity: zigzag O(N); vertical O(N log N)
+ * Space Complexity: O(N) values + O(levels / columns) offsets
+ *
+ * Build: g++ -std=c++17 -O2 flat_traversals.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <map>
+#include <set>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "../../tools/alloc_counter.h"  // g_alloc: proves steady-state calls allocate nothing
+using namespace std;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== FLAT OUTPUT ====================
+
+/**
+ * Rows stored back to back: row r is values[offsets[r], offsets[r + 1])
+ */
+struct FlatRows {
+    vector<int> values;
+    vector<int> offsets = {0};
+
+    size_t rows() const { return offsets.size() - 1; }
+    const int* begin(size_t r) const { return values.data() + offsets[r]; }
+    const int* end(size_t r) const { return values.data() + offsets[r + 1]; }
+    int rowSize(size_t r) const { return offsets[r + 1] - offsets[r]; }
+
+    // Empties the rows but keeps both capacities
+    void clear() {
+        values.clear();
+        offsets.resize(1);
+    }
+
+    vector<vector<int>> toVector() const {
+        vector<vector<int>> nested;
+        for (size_t r = 0; r < rows(); r++)
+            nested.emplace_back(begin(r), end(r));
+        return nested;
+    }
+};
+
+class FlatSolution {
+public:
+    /**
+     * Zigzag level order (see zigzag_bt.cpp) into out, one row per level
+     */
+    void zigzagLevelOrder(TreeNode* root, FlatRows& out) {
+        out.clear();
+        if (!root) return;
+
+        frontier.clear();
+        frontier.push_back(root);
+        bool leftToRight = true;
+
+        size_t levelBegin = 0;
+        while (levelBegin < frontier.size()) {
+            size_t levelEnd = frontier.size();
+            int size = levelEnd - levelBegin;
+            size_t base = out.values.size();
+            out.values.resize(base + size);
+
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = frontier[levelBegin + i];
+                int index = (leftToRight) ? i : (size - 1 - i);
+                out.values[base + index] = node->val;
+
+                if (node->left) frontier.push_back(node->left);
+                if (node->right) frontier.push_back(node->right);
+            }
+
+            out.offsets.push_back(out.values.size());
+            leftToRight = !leftToRight;
+            levelBegin = levelEnd;
+        }
+    }
+
+    /**
+     * Vertical order traversal (see verticalTravers.cpp) into out, one row per column
+     */
+    void verticalTraversal(TreeNode* root, FlatRows& out) {
+        out.clear();
+        if (!root) return;
+
+        frontier.clear();
+        records.clear();
+        frontier.push_back(root);
+        records.push_back({0, 0, root->val});
+
+        // records[i] holds the coordinates of frontier[i]
+        for (size_t head = 0; head < frontier.size(); head++) {
+            TreeNode* node = frontier[head];
+            int x = records[head].column, y = records[head].row;
+
+            if (node->left) {
+                frontier.push_back(node->left);
+                records.push_back({x - 1, y + 1, node->left->val});
+            }
+            if (node->right) {
+                frontier.push_back(node->right);
+                records.push_back({x + 1, y + 1, node->right->val});
+            }
+        }
+
+        sort(records.begin(), records.end());
+
+        out.values.resize(records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            if (i > 0 && records[i].column != records[i - 1].column)
+                out.offsets.push_back(i);
+            out.values[i] = records[i].value;
+        }
+        out.offsets.push_back(records.size());
+    }
+
+private:
+    struct Record {
+        int column, row, value;
+        bool operator<(const Record& o) const {
+            if (column != o.column) return column < o.column;
+            if (row != o.row) return row < o.row;
+            return value < o.value;
+        }
+    };
+
+    vector<TreeNode*> frontier;  // BFS order; each level is a contiguous range
+    vector<Record> records;      // vertical traversal coordinates
+};
+
+// ==================== REFERENCE SOLUTIONS ====================
+
+class Solution {
+public:
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left)
+                    q.push(node->left);
+                if (node->right)
+                    q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) {
+                todo.push({node->left, {x - 1, y + 1}});
+            }
+            if (node->right) {
+                todo.push({node->right, {x + 1, y + 1}});
+            }
+        }
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second) {
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            }
+            answer.push_back(col);
+        }
+        return answer;
+    }
+};
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Random tree: each new node hangs off a random free child slot
+TreeNode* randomTree(int n, int valueRange, mt19937& rng) {
+    if (n == 0) return nullptr;
+    TreeNode* root = new TreeNode(rng() % valueRange);
+    vector<TreeNode**> slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        TreeNode* node = new TreeNode(rng() % valueRange);
+        *slots[s] = node;
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&node->left);
+        slots.push_back(&node->right);
+    }
+    return root;
+}
+
+void deleteTree(TreeNode* root) {
+    if (!root) return;
+    deleteTree(root->left);
+    deleteTree(root->right);
+    delete root;
+}
+
+void printFlat(const FlatRows& rows) {
+    cout << "values=[";
+    for (size_t i = 0; i < rows.values.size(); i++)
+        cout << rows.values[i] << (i + 1 < rows.values.size() ? "," : "");
+    cout << "] offsets=[";
+    for (size_t i = 0; i < rows.offsets.size(); i++)
+        cout << rows.offsets[i] << (i + 1 < rows.offsets.size() ? "," : "");
+    cout << "]" << endl;
+}
+
+int main() {
+    Solution solution;
+    FlatSolution flat;
+    FlatRows rows;
+
+    // Test Case 1: [3,9,20,null,null,15,7]
+    // Tree:       3
+    //            / \
+    //           9   20
+    //              /  \
+    //             15   7
+    cout << "Test Case 1:" << endl;
+    TreeNode* root1 = new TreeNode(3, new TreeNode(9), new TreeNode(20, new TreeNode(15), new TreeNode(7)));
+    flat.zigzagLevelOrder(root1, rows);
+    cout << "Zigzag:   ";
+    printFlat(rows);
+    flat.verticalTraversal(root1, rows);
+    cout << "Vertical: ";
+    printFlat(rows);
+    cout << "Expected: values=[3,20,9,15,7] offsets=[0,1,3,5]" << endl;
+    cout << "          values=[9,3,15,20,7] offsets=[0,1,3,4,5]" << endl << endl;
+    deleteTree(root1);
+
+    // Test Case 2: random trees (with duplicate values) vs the nested versions
+    cout << "Test Case 2 (vs zigzagLevelOrder / verticalTraversal):" << endl;
+    mt19937 rng(40);
+    bool ok = true;
+    for (int t = 0; t < 300; t++) {
+        TreeNode* root = randomTree(rng() % 400, (t % 2) ? 5 : 1000, rng);
+        flat.zigzagLevelOrder(root, rows);
+        ok &= rows.toVector() == solution.zigzagLevelOrder(root);
+        flat.verticalTraversal(root, rows);
+        ok &= rows.toVector() == solution.verticalTraversal(root);
+        deleteTree(root);
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: allocations and time per call after warm-up
+    const int calls = 200;
+    cout << "Test Case 3 (" << calls << " calls on a 2^16-node tree):" << endl;
+    TreeNode* big = randomTree(1 << 16, 1000000, rng);
+    flat.zigzagLevelOrder(big, rows);  // warm-up: buffers grow to this tree's size
+    flat.verticalTraversal(big, rows);
+
+    long long sink = 0;
+    bool noAllocations = true;
+    for (int which = 0; which < 2; which++) {
+        long long before = g_alloc.allocations.load();
+        auto start = chrono::steady_clock::now();
+        for (int c = 0; c < calls; c++)
+            sink += which == 0 ? solution.zigzagLevelOrder(big).size() : solution.verticalTraversal(big).size();
+        double nestedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        long long nestedAllocs = g_alloc.allocations.load() - before;
+
+        before = g_alloc.allocations.load();
+        start = chrono::steady_clock::now();
+        for (int c = 0; c < calls; c++) {
+            if (which == 0) flat.zigzagLevelOrder(big, rows);
+            else flat.verticalTraversal(big, rows);
+            sink += rows.rows();
+        }
+        double flatMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        long long flatAllocs = g_alloc.allocations.load() - before;
+
+        cout << "  " << (which == 0 ? "zigzag" : "vertical") << ": nested " << nestedMs << " ms, "
+             << nestedAllocs / calls << " allocations/call   flat " << flatMs << " ms, "
+             << flatAllocs / calls << " allocations/call" << endl;
+        noAllocations &= flatAllocs == 0;
+    }
+    cout << "Expected: flat 0 allocations/call" << endl;
+    cout << (noAllocations ? "PASSED ✓" : "FAILED ✗") << endl;
+    if (sink == 0) cout << endl;
+
+    deleteTree(big);
+    return 0;
+}
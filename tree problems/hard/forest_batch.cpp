@@ -0,0 +1,309 @@
+/**
+ * Forest Batch Evaluation (diameter and max path sum over many small trees)
+ *
+ * Problem: Millions of small trees (50-500 nodes) are evaluated one Solution
+ * call at a time. Each call pays for recursion and follows pointers to nodes
+ * scattered across the heap, and that overhead costs more than the metric.
+ *
+ * Approach: One flat arena for the whole forest, one loop per tree
+ * - Forest stores every node in three parallel arrays (val, left, right),
+ *   with the trees one after another and offsets[t] marking where tree t
+ *   starts
+ * - Each tree is laid out in BFS order, so every child comes after its
+ *   parent. Walking a tree's nodes from last to first is therefore a valid
+ *   post-order: both children are finished before their parent, with no
+ *   recursion and no stack
+ * - Child links are 1-based indices within the tree, and 0 means null. Slot 0
+ *   of the scratch array always holds 0 (height of an empty subtree, gain of
+ *   nothing), so a missing child needs no branch
+ * - The batch APIs split the trees into contiguous chunks with roughly equal
+ *   node counts, one chunk per thread. Each thread reuses one scratch array
+ *   for all of its trees
+ *
+ * Results match Solution::diameterOfBinaryTree / Solution::maxPathSum tree by tree.
+ *
+ * Time Complexity: O(total nodes) / threads
+ * Space Complexity: 12 bytes per node in the arena + O(max tree size) per thread
+ *
+ * Usage: ./forest_batch [trees] [threads]   (default 100000 trees)
+ * Build: g++ -std=c++17 -O2 -pthread forest_batch.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+
+    // Constructors
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== REFERENCE SOLUTIONS ====================
+
+class Solution {
+public:
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+private:
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL)
+            return 0;
+        int leftDepth = depth(root->left, diameter);
+        int rightDepth = depth(root->right, diameter);
+        diameter = max(diameter, leftDepth + rightDepth);
+        return 1 + max(leftDepth, rightDepth);
+    }
+
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL)
+            return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+};
+
+// ==================== FOREST ARENA ====================
+
+class Forest {
+public:
+    /**
+     * Appends a tree (copied in BFS order); an empty tree is allowed
+     */
+    void addTree(TreeNode* root) {
+        offsets.push_back(val.size());
+        if (!root) return;
+
+        size_t base = val.size();
+        queue<TreeNode*> q;
+        q.push(root);
+        int next = 1;  // 1-based index of the next node to be placed
+        while (!q.empty()) {
+            TreeNode* node = q.front();
+            q.pop();
+            val.push_back(node->val);
+            left.push_back(node->left ? ++next : 0);
+            if (node->left) q.push(node->left);
+            right.push_back(node->right ? ++next : 0);
+            if (node->right) q.push(node->right);
+        }
+        maxTreeSize = max(maxTreeSize, val.size() - base);
+    }
+
+    size_t treeCount() const { return offsets.size(); }
+    size_t nodeCount() const { return val.size(); }
+    size_t treeSize(size_t t) const { return end(t) - offsets[t]; }
+
+    /**
+     * Diameter (edges) of tree t; scratch must hold treeSize(t) + 1 ints
+     */
+    int diameter(size_t t, int* height) const {
+        size_t base = offsets[t];
+        int n = treeSize(t);
+        const int* L = left.data() + base;
+        const int* R = right.data() + base;
+
+        int best = 0;
+        height[0] = 0;
+        for (int i = n - 1; i >= 0; i--) {
+            int hl = height[L[i]], hr = height[R[i]];
+            best = max(best, hl + hr);
+            height[i + 1] = 1 + max(hl, hr);
+        }
+        return best;
+    }
+
+    /**
+     * Maximum path sum of tree t (INT_MIN for an empty tree); scratch as above
+     */
+    int maxPathSum(size_t t, int* gain) const {
+        size_t base = offsets[t];
+        int n = treeSize(t);
+        const int* V = val.data() + base;
+        const int* L = left.data() + base;
+        const int* R = right.data() + base;
+
+        int best = INT_MIN;
+        gain[0] = 0;
+        for (int i = n - 1; i >= 0; i--) {
+            int gl = max(0, gain[L[i]]), gr = max(0, gain[R[i]]);
+            best = max(best, gl + gr + V[i]);
+            gain[i + 1] = V[i] + max(gl, gr);
+        }
+        return best;
+    }
+
+    // Tree chunks [first, last) with about the same number of nodes each
+    vector<size_t> chunks(unsigned parts) const {
+        vector<size_t> bounds = {0};
+        size_t target = nodeCount() / max(1u, parts) + 1, acc = 0;
+        for (size_t t = 0; t < treeCount(); t++) {
+            acc += treeSize(t);
+            if (acc >= target && bounds.size() < parts) {
+                bounds.push_back(t + 1);
+                acc = 0;
+            }
+        }
+        bounds.push_back(treeCount());
+        return bounds;
+    }
+
+    size_t largestTree() const { return maxTreeSize; }
+
+private:
+    vector<int> val, left, right;  // SoA node arena, links 1-based within a tree
+    vector<size_t> offsets;        // first node of each tree
+    size_t maxTreeSize = 0;
+
+    size_t end(size_t t) const { return t + 1 < offsets.size() ? offsets[t + 1] : val.size(); }
+};
+
+// ==================== BATCH API ====================
+
+/**
+ * out[t] = metric(t, scratch) for every tree, with trees split across threads
+ */
+template <typename Metric>
+vector<int> batchEvaluate(const Forest& forest, unsigned threads, Metric metric) {
+    vector<int> out(forest.treeCount());
+    vector<size_t> bounds = forest.chunks(max(1u, threads));
+
+    auto work = [&](size_t first, size_t last) {
+        vector<int> scratch(forest.largestTree() + 1);
+        for (size_t t = first; t < last; t++)
+            out[t] = metric(t, scratch.data());
+    };
+
+    vector<thread> workers;
+    for (size_t c = 1; c + 1 < bounds.size(); c++)
+        workers.emplace_back(work, bounds[c], bounds[c + 1]);
+    work(bounds[0], bounds.size() > 1 ? bounds[1] : forest.treeCount());
+    for (auto& w : workers) w.join();
+    return out;
+}
+
+vector<int> batchDiameter(const Forest& forest, unsigned threads = 1) {
+    return batchEvaluate(forest, threads, [&](size_t t, int* s) { return forest.diameter(t, s); });
+}
+
+vector<int> batchMaxPathSum(const Forest& forest, unsigned threads = 1) {
+    return batchEvaluate(forest, threads, [&](size_t t, int* s) { return forest.maxPathSum(t, s); });
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+// Random tree: each new node hangs off a random free child slot
+TreeNode* randomTree(int n, mt19937& rng) {
+    if (n == 0) return nullptr;
+    vector<TreeNode*> nodes;
+    vector<TreeNode**> slots;
+    TreeNode* root = new TreeNode((int)(rng() % 2001) - 1000);
+    nodes.push_back(root);
+    slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        TreeNode* node = new TreeNode((int)(rng() % 2001) - 1000);
+        *slots[s] = node;
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&node->left);
+        slots.push_back(&node->right);
+    }
+    return root;
+}
+
+void deleteTree(TreeNode* root) {
+    if (!root) return;
+    deleteTree(root->left);
+    deleteTree(root->right);
+    delete root;
+}
+
+int main(int argc, char* argv[]) {
+    int treeCount = (argc > 1) ? atoi(argv[1]) : 100000;
+    unsigned threads = (argc > 2) ? atoi(argv[2]) : max(2u, thread::hardware_concurrency());
+    Solution solution;
+
+    // Test Case 1: the examples from bt_diameter.cpp and bt_maxPathSum.cpp
+    // Tree 0:      1           Tree 1:   -10
+    //             / \                   /   \
+    //            2   3                 9     20
+    //           / \                         /  \
+    //          4   5                       15   7
+    cout << "Test Case 1:" << endl;
+    Forest small;
+    TreeNode* t0 = new TreeNode(1, new TreeNode(2, new TreeNode(4), new TreeNode(5)), new TreeNode(3));
+    TreeNode* t1 = new TreeNode(-10, new TreeNode(9), new TreeNode(20, new TreeNode(15), new TreeNode(7)));
+    small.addTree(t0);
+    small.addTree(t1);
+    small.addTree(nullptr);
+    vector<int> d = batchDiameter(small), p = batchMaxPathSum(small);
+    cout << "Diameters: " << d[0] << " " << d[1] << " " << d[2] << endl;
+    cout << "Max path sums: " << p[0] << " " << p[1] << " " << (p[2] == INT_MIN ? "INT_MIN" : "?") << endl;
+    cout << "Expected: 3 3 0 / 11 42 INT_MIN" << endl << endl;
+    deleteTree(t0);
+    deleteTree(t1);
+
+    // Test Case 2: random forest vs Solution, serial and parallel
+    cout << "Test Case 2 (" << treeCount << " trees of 50-500 nodes):" << endl;
+    mt19937 rng(37);
+    vector<TreeNode*> roots(treeCount);
+    Forest forest;
+    for (int t = 0; t < treeCount; t++) {
+        roots[t] = randomTree(50 + rng() % 451, rng);
+        forest.addTree(roots[t]);
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<int> refD(treeCount), refP(treeCount);
+    for (int t = 0; t < treeCount; t++) {
+        refD[t] = solution.diameterOfBinaryTree(roots[t]);
+        refP[t] = solution.maxPathSum(roots[t]);
+    }
+    double refMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<int> serialD = batchDiameter(forest), serialP = batchMaxPathSum(forest);
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<int> parD = batchDiameter(forest, threads), parP = batchMaxPathSum(forest, threads);
+    double parMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    bool ok = serialD == refD && serialP == refP && parD == refD && parP == refP;
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << "  (" << forest.nodeCount() << " nodes)" << endl << endl;
+
+    // Test Case 3: timing of both metrics over the whole forest
+    cout << "Test Case 3 (timing, both metrics):" << endl;
+    cout << "  Solution per tree: " << refMs << " ms" << endl;
+    cout << "  forest batch: " << serialMs << " ms" << endl;
+    cout << "  forest batch, " << threads << " threads: " << parMs << " ms" << endl;
+
+    for (TreeNode* root : roots) deleteTree(root);
+    return 0;
+}
@@ -0,0 +1,342 @@
+/**
+ * Parallel Vertical Order Traversal (deterministic, per-thread column shards)
+ *
+ * Problem: verticalTraversal (see verticalTravers.cpp) visits every node
+ * sequentially and inserts into one shared map<column, map<row, multiset>>.
+ * For trees with millions of nodes and thousands of columns, that single
+ * map is the bottleneck.
+ *
+ * Approach: Split into subtrees, record locally, then merge with a bucket pass
+ * - Split: a short BFS from the root expands nodes until there are about
+ *   TASKS_PER_THREAD subtrees per thread. The expanded top nodes go into a
+ *   buffer of their own, and the remaining frontier nodes become the tasks
+ * - Record: each thread takes tasks from a shared atomic counter and walks
+ *   each subtree with an explicit stack, appending (column, row, value) to its
+ *   own buffer and tracking its own column range. Threads share no containers
+ * - Count: every buffer builds a histogram over the global column range
+ * - Place: prefix sums over (column, buffer) give each buffer a private
+ *   output range in every column, and the buffers scatter into those ranges
+ *   in parallel. Each record becomes one 64-bit key, row in the high half and
+ *   value (sign bit flipped) in the low half
+ * - Sort: columns are split into ranges with about the same number of
+ *   records each, and each thread sorts its columns' keys and builds their
+ *   output rows. Sorting by (row, value) is exactly the map<row, multiset>
+ *   order, and equal keys are identical values, so the output does not depend
+ *   on which thread saw which subtree
+ *
+ * Columns of a tree are contiguous (each child is one column from its parent),
+ * so the histogram has no gaps.
+ *
+ * Time Complexity: O(N log N / threads + columns * threads)
+ * Space Complexity: O(N) records + O(columns * threads) counts
+ *
+ * Usage: ./parallel_vertical [nodes] [threads]   (default 2^21 nodes)
+ * Build: g++ -std=c++17 -O2 -pthread parallel_vertical.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <queue>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+using namespace std;
+
+const size_t TASKS_PER_THREAD = 8;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== REFERENCE SOLUTION ====================
+
+class Solution {
+public:
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) {
+                todo.push({node->left, {x - 1, y + 1}});
+            }
+            if (node->right) {
+                todo.push({node->right, {x + 1, y + 1}});
+            }
+        }
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second) {
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            }
+            answer.push_back(col);
+        }
+        return answer;
+    }
+};
+
+// ==================== PARALLEL VERSION ====================
+
+// Runs fn(0) .. fn(parts - 1) on parts threads (fn(0) on the caller)
+template <typename Fn>
+void parallelFor(unsigned parts, Fn fn) {
+    vector<thread> workers;
+    for (unsigned p = 1; p < parts; p++) workers.emplace_back(fn, p);
+    fn(0);
+    for (auto& w : workers) w.join();
+}
+
+class ParallelVertical {
+public:
+    struct Record {
+        int column, row, value;
+    };
+
+    explicit ParallelVertical(unsigned threads) : threads(max(1u, threads)) {}
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+        split(root);
+        record();
+
+        int minColumn = INT_MAX, maxColumn = INT_MIN;
+        for (const Shard& s : shards) {
+            if (s.records.empty()) continue;
+            minColumn = min(minColumn, s.minColumn);
+            maxColumn = max(maxColumn, s.maxColumn);
+        }
+        size_t columns = maxColumn - minColumn + 1;
+
+        // Count: one histogram per shard
+        unsigned shardCount = shards.size();
+        parallelFor(min(threads, shardCount), [&](unsigned t) {
+            for (unsigned s = t; s < shardCount; s += threads) {
+                shards[s].counts.assign(columns, 0);
+                for (const Record& r : shards[s].records)
+                    shards[s].counts[r.column - minColumn]++;
+            }
+        });
+
+        // Place: column c starts at columnStart[c]; shard s writes after shards < s
+        vector<size_t> columnStart(columns + 1, 0);
+        for (size_t c = 0; c < columns; c++) {
+            size_t at = columnStart[c];
+            for (Shard& s : shards) {
+                size_t n = s.counts[c];
+                s.counts[c] = at;  // becomes this shard's write cursor
+                at += n;
+            }
+            columnStart[c + 1] = at;
+        }
+
+        vector<uint64_t> keys(columnStart[columns]);
+        parallelFor(min(threads, shardCount), [&](unsigned t) {
+            for (unsigned s = t; s < shardCount; s += threads) {
+                vector<size_t>& cursor = shards[s].counts;
+                for (const Record& r : shards[s].records)
+                    keys[cursor[r.column - minColumn]++] = key(r);
+            }
+        });
+
+        // Sort: column ranges with about the same number of records per thread
+        vector<size_t> bounds = {0};
+        size_t total = keys.size();
+        for (size_t c = 0; c + 1 < columns && bounds.size() < threads; c++)
+            if (columnStart[c + 1] * threads >= total * bounds.size()) bounds.push_back(c + 1);
+        bounds.push_back(columns);
+
+        vector<vector<int>> answer(columns);
+        parallelFor(bounds.size() - 1, [&](unsigned t) {
+            for (size_t c = bounds[t]; c < bounds[t + 1]; c++) {
+                uint64_t* first = keys.data() + columnStart[c];
+                uint64_t* last = keys.data() + columnStart[c + 1];
+                sort(first, last);
+                answer[c].reserve(last - first);
+                for (uint64_t* k = first; k < last; k++)
+                    answer[c].push_back((int)((uint32_t)*k ^ 0x80000000u));
+            }
+        });
+        return answer;
+    }
+
+private:
+    struct Shard {
+        vector<Record> records;
+        int minColumn = INT_MAX, maxColumn = INT_MIN;
+        vector<size_t> counts;  // per-column count, then write cursor
+
+        void add(int column, int row, int value) {
+            records.push_back({column, row, value});
+            minColumn = min(minColumn, column);
+            maxColumn = max(maxColumn, column);
+        }
+    };
+
+    struct Task {
+        TreeNode* node;
+        int column, row;
+    };
+
+    // Rows are non-negative, so (row, value ^ sign bit) sorts as (row, value)
+    static uint64_t key(const Record& r) {
+        return ((uint64_t)(uint32_t)r.row << 32) | ((uint32_t)r.value ^ 0x80000000u);
+    }
+
+    // Expands the top of the tree into shards.back() until there are enough tasks
+    void split(TreeNode* root) {
+        shards.assign(threads + 1, Shard());
+        Shard& top = shards.back();
+        tasks.clear();
+        tasks.push_back({root, 0, 0});
+
+        size_t head = 0;
+        while (head < tasks.size() && tasks.size() - head < threads * TASKS_PER_THREAD) {
+            Task t = tasks[head++];
+            top.add(t.column, t.row, t.node->val);
+            if (t.node->left) tasks.push_back({t.node->left, t.column - 1, t.row + 1});
+            if (t.node->right) tasks.push_back({t.node->right, t.column + 1, t.row + 1});
+        }
+        tasks.erase(tasks.begin(), tasks.begin() + head);
+    }
+
+    // Each thread claims subtrees and records them into its own shard
+    void record() {
+        atomic<size_t> next(0);
+        parallelFor(threads, [&](unsigned t) {
+            Shard& shard = shards[t];
+            vector<Task> stack;
+            for (size_t i; (i = next.fetch_add(1, memory_order_relaxed)) < tasks.size();) {
+                stack.push_back(tasks[i]);
+                while (!stack.empty()) {
+                    Task cur = stack.back();
+                    stack.pop_back();
+                    shard.add(cur.column, cur.row, cur.node->val);
+                    if (cur.node->right) stack.push_back({cur.node->right, cur.column + 1, cur.row + 1});
+                    if (cur.node->left) stack.push_back({cur.node->left, cur.column - 1, cur.row + 1});
+                }
+            }
+        });
+    }
+
+    unsigned threads;
+    vector<Shard> shards;  // one per thread, plus the expanded top of the tree
+    vector<Task> tasks;
+};
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+/**
+ * Random tree in nodes[0..n). With probability `deep` a new node becomes the
+ * right child of the previous one, which grows long diagonals and many columns
+ */
+TreeNode* randomTree(vector<TreeNode>& nodes, int n, int valueRange, double deep, mt19937& rng) {
+    nodes.assign(n, TreeNode());
+    if (n == 0) return nullptr;
+    uniform_real_distribution<double> coin(0, 1);
+    for (TreeNode& node : nodes) node.val = (int)(rng() % valueRange) - valueRange / 2;
+    vector<TreeNode**> slots = {&nodes[0].left, &nodes[0].right};
+    for (int i = 1; i < n; i++) {
+        size_t s = coin(rng) < deep ? slots.size() - 1 : rng() % slots.size();
+        *slots[s] = &nodes[i];
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&nodes[i].left);
+        slots.push_back(&nodes[i].right);
+    }
+    return &nodes[0];
+}
+
+void printColumns(const vector<vector<int>>& columns) {
+    cout << "[";
+    for (size_t c = 0; c < columns.size(); c++) {
+        cout << (c ? ",[" : "[");
+        for (size_t i = 0; i < columns[c].size(); i++)
+            cout << columns[c][i] << (i + 1 < columns[c].size() ? "," : "");
+        cout << "]";
+    }
+    cout << "]" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int bigN = (argc > 1) ? atoi(argv[1]) : 1 << 21;
+    unsigned threads = (argc > 2) ? atoi(argv[2]) : max(2u, thread::hardware_concurrency());
+    Solution solution;
+    ParallelVertical parallel(threads);
+
+    // Test Case 1: [1,2,3,4,6,5,7] - 5 and 6 share a coordinate
+    // Tree:        1
+    //            /   \
+    //           2     3
+    //          / \   / \
+    //         4   6 5   7
+    cout << "Test Case 1:" << endl;
+    TreeNode n4(4), n6(6), n5(5), n7(7);
+    TreeNode n2(2, &n4, &n6), n3(3, &n5, &n7), n1(1, &n2, &n3);
+    vector<vector<int>> result = parallel.verticalTraversal(&n1);
+    cout << "Output: ";
+    printColumns(result);
+    cout << "Expected: [[4],[2],[1,5,6],[3],[7]]" << endl << endl;
+
+    // Test Case 2: empty tree and a single node
+    cout << "Test Case 2 (empty, single node):" << endl;
+    TreeNode lone(-7);
+    bool ok2 = parallel.verticalTraversal(nullptr).empty() &&
+               parallel.verticalTraversal(&lone) == vector<vector<int>>{{-7}};
+    cout << (ok2 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: random shapes, duplicates and thread counts vs Solution
+    cout << "Test Case 3 (500 random trees, 1-7 threads, vs Solution):" << endl;
+    mt19937 rng(44);
+    vector<TreeNode> pool;
+    bool ok3 = true;
+    for (int t = 0; t < 500; t++) {
+        TreeNode* root = randomTree(pool, rng() % 2000, (t % 2) ? 4 : 2000000, (t % 3) * 0.45, rng);
+        ParallelVertical p(1 + t % 7);
+        ok3 &= p.verticalTraversal(root) == solution.verticalTraversal(root);
+    }
+    cout << (ok3 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: a large, wide tree
+    cout << "Test Case 4 (" << bigN << " nodes, " << threads << " threads):" << endl;
+    TreeNode* big = randomTree(pool, bigN, 1000, 0.99, rng);
+
+    auto start = chrono::steady_clock::now();
+    vector<vector<int>> expected = solution.verticalTraversal(big);
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<vector<int>> single = ParallelVertical(1).verticalTraversal(big);
+    double oneMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<vector<int>> many = parallel.verticalTraversal(big);
+    double manyMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "  columns: " << expected.size() << endl;
+    cout << "  Solution (map of maps): " << serialMs << " ms" << endl;
+    cout << "  shards, 1 thread: " << oneMs << " ms" << endl;
+    cout << "  shards, " << threads << " threads: " << manyMs << " ms" << endl;
+    cout << ((single == expected && many == expected) ? "PASSED ✓" : "FAILED ✗") << endl;
+    return 0;
+}
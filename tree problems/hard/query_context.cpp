@@ -0,0 +1,648 @@
+/**
+ * Tree Queries with a Reusable Query Context
+ *
+ * Problem: Many threads run the tree Solution methods (maxPathSum, diameter,
+ * rightSideView, zigzagLevelOrder, verticalTraversal, boundaryTraversal) against
+ * the same large, read-only tree. The original versions allocate their own
+ * queues, vectors and maps on every call, so at high thread counts the global
+ * allocator becomes the bottleneck.
+ *
+ * Approach: Caller-owned scratch buffers
+ * - A QueryContext holds every buffer the algorithms need (frontier arrays,
+ *   explicit DFS stacks, coordinate records, result vectors)
+ * - Buffers are cleared between calls but keep their capacity, so after the
+ *   first few queries (warm-up) no call touches the heap again
+ * - threadContext() hands out one context per thread (thread_local), so readers
+ *   never share mutable state and need no locks: the tree itself is immutable
+ * - Recursion is replaced by explicit stacks stored in the context, which also
+ *   removes the stack-overflow risk on deep (skewed) trees
+ *
+ * Results are returned as const references into the context and stay valid
+ * until the next query on the same context.
+ *
+ * Time Complexity: same as the original solutions
+ * Space Complexity: O(N) scratch per thread, allocated once
+ *
+ * Build: g++ -std=c++17 -O2 -pthread query_context.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <map>
+#include <set>
+#include <tuple>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include "../../tools/alloc_counter.h"  // g_alloc: proves steady-state queries allocate nothing
+using namespace std;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+/**
+ * Per-thread scratch space shared by all tree queries.
+ * Nothing in here is ever shrunk, only cleared.
+ */
+struct QueryContext {
+    // BFS frontiers (current level / next level)
+    vector<TreeNode*> frontier;
+    vector<TreeNode*> nextFrontier;
+
+    // Explicit DFS stack: node + "children already pushed" flag
+    vector<pair<TreeNode*, bool>> stack;
+
+    // Post-order return values (subtree heights / downward path sums)
+    vector<int> values;
+
+    // Coordinate records for vertical traversal: {column, row, value}
+    vector<tuple<int, int, int>> records;
+    vector<pair<TreeNode*, pair<int, int>>> coordFrontier;
+
+    // Result storage. Nested results keep every inner vector alive between
+    // calls and track how many of them are in use.
+    vector<int> flat;
+    vector<int> temp;
+    vector<vector<int>> nested;
+
+    // Hand out the next inner vector of `nested`, reusing old capacity
+    vector<int>& nextRow(size_t& used) {
+        if (used == nested.size())
+            nested.emplace_back();
+        vector<int>& row = nested[used++];
+        row.clear();
+        return row;
+    }
+};
+
+/**
+ * One context per thread. Readers of a shared immutable tree never touch
+ * each other's buffers, so no synchronization is needed.
+ */
+QueryContext& threadContext() {
+    thread_local QueryContext ctx;
+    return ctx;
+}
+
+/**
+ * View over the used prefix of QueryContext::nested
+ */
+struct NestedResult {
+    const vector<vector<int>>* rows;
+    size_t count;
+
+    size_t size() const { return count; }
+    const vector<int>& operator[](size_t i) const { return (*rows)[i]; }
+
+    vector<vector<int>> toVector() const {
+        return vector<vector<int>>(rows->begin(), rows->begin() + count);
+    }
+};
+
+class ContextSolution {
+public:
+    /**
+     * Maximum path sum (see bt_maxPathSum.cpp), iterative post-order
+     */
+    int maxPathSum(TreeNode* root, QueryContext& ctx) {
+        int maxi = INT_MIN;
+        if (!root) return maxi;
+
+        ctx.stack.clear();
+        ctx.values.clear();
+        ctx.stack.push_back({root, false});
+
+        while (!ctx.stack.empty()) {
+            auto& top = ctx.stack.back();
+            TreeNode* node = top.first;
+
+            if (!top.second) {
+                // First visit: schedule children, revisit the node afterwards
+                top.second = true;
+                if (node->right) ctx.stack.push_back({node->right, false});
+                if (node->left) ctx.stack.push_back({node->left, false});
+                continue;
+            }
+
+            ctx.stack.pop_back();
+
+            // Children results were pushed left first, then right
+            int rightSum = 0, leftSum = 0;
+            if (node->right) { rightSum = max(0, ctx.values.back()); ctx.values.pop_back(); }
+            if (node->left) { leftSum = max(0, ctx.values.back()); ctx.values.pop_back(); }
+
+            maxi = max(maxi, leftSum + rightSum + node->val);
+            ctx.values.push_back(node->val + max(leftSum, rightSum));
+        }
+        return maxi;
+    }
+
+    /**
+     * Diameter in edges (see bt_diameter.cpp), iterative post-order
+     */
+    int diameterOfBinaryTree(TreeNode* root, QueryContext& ctx) {
+        int diameter = 0;
+        if (!root) return diameter;
+
+        ctx.stack.clear();
+        ctx.values.clear();
+        ctx.stack.push_back({root, false});
+
+        while (!ctx.stack.empty()) {
+            auto& top = ctx.stack.back();
+            TreeNode* node = top.first;
+
+            if (!top.second) {
+                top.second = true;
+                if (node->right) ctx.stack.push_back({node->right, false});
+                if (node->left) ctx.stack.push_back({node->left, false});
+                continue;
+            }
+
+            ctx.stack.pop_back();
+
+            int rh = 0, lh = 0;
+            if (node->right) { rh = ctx.values.back(); ctx.values.pop_back(); }
+            if (node->left) { lh = ctx.values.back(); ctx.values.pop_back(); }
+
+            diameter = max(diameter, lh + rh);
+            ctx.values.push_back(1 + max(lh, rh));
+        }
+        return diameter;
+    }
+
+    /**
+     * Right side view (see bt_sideView.cpp): last node of every BFS level
+     */
+    const vector<int>& rightSideView(TreeNode* root, QueryContext& ctx) {
+        ctx.flat.clear();
+        if (!root) return ctx.flat;
+
+        ctx.frontier.clear();
+        ctx.frontier.push_back(root);
+
+        while (!ctx.frontier.empty()) {
+            ctx.flat.push_back(ctx.frontier.back()->val);
+
+            ctx.nextFrontier.clear();
+            for (TreeNode* node : ctx.frontier) {
+                if (node->left) ctx.nextFrontier.push_back(node->left);
+                if (node->right) ctx.nextFrontier.push_back(node->right);
+            }
+            ctx.frontier.swap(ctx.nextFrontier);
+        }
+        return ctx.flat;
+    }
+
+    /**
+     * Zigzag level order (see zigzag_bt.cpp)
+     */
+    NestedResult zigzagLevelOrder(TreeNode* root, QueryContext& ctx) {
+        size_t used = 0;
+        if (!root) return {&ctx.nested, used};
+
+        ctx.frontier.clear();
+        ctx.frontier.push_back(root);
+        bool leftToRight = true;
+
+        while (!ctx.frontier.empty()) {
+            int size = ctx.frontier.size();
+            vector<int>& level = ctx.nextRow(used);
+            level.resize(size);
+
+            ctx.nextFrontier.clear();
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = ctx.frontier[i];
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+
+                if (node->left) ctx.nextFrontier.push_back(node->left);
+                if (node->right) ctx.nextFrontier.push_back(node->right);
+            }
+
+            leftToRight = !leftToRight;
+            ctx.frontier.swap(ctx.nextFrontier);
+        }
+        return {&ctx.nested, used};
+    }
+
+    /**
+     * Vertical order traversal (see verticalTravers.cpp)
+     *
+     * The map<int, map<int, multiset<int>>> is replaced by a flat list of
+     * (column, row, value) records sorted in place. Sorting by the full tuple
+     * gives exactly the map/multiset iteration order.
+     */
+    NestedResult verticalTraversal(TreeNode* root, QueryContext& ctx) {
+        size_t used = 0;
+        if (!root) return {&ctx.nested, used};
+
+        ctx.records.clear();
+        ctx.coordFrontier.clear();
+        ctx.coordFrontier.push_back({root, {0, 0}});
+
+        // Frontier array used as a queue: head index instead of pop_front
+        for (size_t head = 0; head < ctx.coordFrontier.size(); head++) {
+            TreeNode* node = ctx.coordFrontier[head].first;
+            int x = ctx.coordFrontier[head].second.first;
+            int y = ctx.coordFrontier[head].second.second;
+
+            ctx.records.emplace_back(x, y, node->val);
+
+            if (node->left) ctx.coordFrontier.push_back({node->left, {x - 1, y + 1}});
+            if (node->right) ctx.coordFrontier.push_back({node->right, {x + 1, y + 1}});
+        }
+
+        // std::sort is in-place (introsort), so no allocation here
+        sort(ctx.records.begin(), ctx.records.end());
+
+        vector<int>* col = nullptr;
+        int currentCol = 0;
+        for (size_t i = 0; i < ctx.records.size(); i++) {
+            int x = get<0>(ctx.records[i]);
+            if (i == 0 || x != currentCol) {
+                col = &ctx.nextRow(used);
+                currentCol = x;
+            }
+            col->push_back(get<2>(ctx.records[i]));
+        }
+        return {&ctx.nested, used};
+    }
+
+    /**
+     * Boundary traversal (see boundaryTravers.cpp), leaves collected with an
+     * explicit stack instead of recursion
+     */
+    const vector<int>& boundaryTraversal(TreeNode* root, QueryContext& ctx) {
+        ctx.flat.clear();
+        if (!root) return ctx.flat;
+
+        if (!isLeaf(root))
+            ctx.flat.push_back(root->val);
+
+        // Left boundary (top to bottom, no leaves)
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right) {
+            if (!isLeaf(curr))
+                ctx.flat.push_back(curr->val);
+        }
+
+        // Leaves, left to right
+        ctx.stack.clear();
+        ctx.stack.push_back({root, false});
+        while (!ctx.stack.empty()) {
+            TreeNode* node = ctx.stack.back().first;
+            ctx.stack.pop_back();
+            if (isLeaf(node)) {
+                ctx.flat.push_back(node->val);
+                continue;
+            }
+            if (node->right) ctx.stack.push_back({node->right, false});
+            if (node->left) ctx.stack.push_back({node->left, false});
+        }
+
+        // Right boundary (bottom to top, no leaves)
+        ctx.temp.clear();
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left) {
+            if (!isLeaf(curr))
+                ctx.temp.push_back(curr->val);
+        }
+        for (int i = (int)ctx.temp.size() - 1; i >= 0; i--)
+            ctx.flat.push_back(ctx.temp[i]);
+
+        return ctx.flat;
+    }
+
+private:
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+};
+
+// ==================== REFERENCE SOLUTIONS (unchanged algorithms) ====================
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+    vector<int> boundaryTraversal(TreeNode* root) {
+        vector<int> result;
+        if (!root) return result;
+        if (!isLeaf(root)) result.push_back(root->val);
+
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right)
+            if (!isLeaf(curr)) result.push_back(curr->val);
+
+        addLeaves(root, result);
+
+        vector<int> temp;
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left)
+            if (!isLeaf(curr)) temp.push_back(curr->val);
+        for (int i = (int)temp.size() - 1; i >= 0; i--)
+            result.push_back(temp[i]);
+        return result;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL) return 0;
+        int lh = depth(root->left, diameter);
+        int rh = depth(root->right, diameter);
+        diameter = max(diameter, lh + rh);
+        return 1 + max(lh, rh);
+    }
+
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+
+    void addLeaves(TreeNode* root, vector<int>& result) {
+        if (isLeaf(root)) {
+            result.push_back(root->val);
+            return;
+        }
+        if (root->left) addLeaves(root->left, result);
+        if (root->right) addLeaves(root->right, result);
+    }
+};
+
+// ==================== UTILITY FUNCTIONS FOR TESTING ====================
+
+/**
+ * Helper function to build a random tree with n nodes (deterministic seed)
+ */
+TreeNode* buildRandomTree(int n, unsigned seed) {
+    if (n <= 0) return nullptr;
+    srand(seed);
+    vector<TreeNode*> nodes;
+    nodes.reserve(n);
+    nodes.push_back(new TreeNode(rand() % 201 - 100));
+
+    while ((int)nodes.size() < n) {
+        TreeNode* parent = nodes[rand() % nodes.size()];
+        TreeNode*& slot = (rand() % 2) ? parent->left : parent->right;
+        if (slot) continue;
+        slot = new TreeNode(rand() % 201 - 100);
+        nodes.push_back(slot);
+    }
+    return nodes[0];
+}
+
+/**
+ * Helper function to delete tree and free memory (iterative, trees can be deep)
+ */
+void deleteTree(TreeNode* root) {
+    vector<TreeNode*> st;
+    if (root) st.push_back(root);
+    while (!st.empty()) {
+        TreeNode* node = st.back();
+        st.pop_back();
+        if (node->left) st.push_back(node->left);
+        if (node->right) st.push_back(node->right);
+        delete node;
+    }
+}
+
+/**
+ * Run every query once on the given context, return a checksum so the
+ * compiler cannot drop the work
+ */
+long long runAllQueries(ContextSolution& sol, TreeNode* root, QueryContext& ctx) {
+    long long sum = 0;
+    sum += sol.maxPathSum(root, ctx);
+    sum += sol.diameterOfBinaryTree(root, ctx);
+    sum += sol.rightSideView(root, ctx).size();
+    sum += sol.zigzagLevelOrder(root, ctx).size();
+    sum += sol.verticalTraversal(root, ctx).size();
+    sum += sol.boundaryTraversal(root, ctx).size();
+    return sum;
+}
+
+/**
+ * The checksum runAllQueries() must produce, computed with the reference Solution
+ */
+long long referenceChecksum(TreeNode* root) {
+    Solution ref;
+    long long sum = 0;
+    sum += ref.maxPathSum(root);
+    sum += ref.diameterOfBinaryTree(root);
+    sum += ref.rightSideView(root).size();
+    sum += ref.zigzagLevelOrder(root).size();
+    sum += ref.verticalTraversal(root).size();
+    sum += ref.boundaryTraversal(root).size();
+    return sum;
+}
+
+bool matchesReference(TreeNode* root) {
+    Solution ref;
+    ContextSolution sol;
+    QueryContext& ctx = threadContext();
+
+    bool ok = true;
+    if (root) {
+        ok &= sol.maxPathSum(root, ctx) == ref.maxPathSum(root);
+    }
+    ok &= sol.diameterOfBinaryTree(root, ctx) == ref.diameterOfBinaryTree(root);
+    ok &= sol.rightSideView(root, ctx) == ref.rightSideView(root);
+    ok &= sol.zigzagLevelOrder(root, ctx).toVector() == ref.zigzagLevelOrder(root);
+    ok &= sol.verticalTraversal(root, ctx).toVector() == ref.verticalTraversal(root);
+    ok &= sol.boundaryTraversal(root, ctx) == ref.boundaryTraversal(root);
+    return ok;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main() {
+    cout << "=== Query Context Test Cases ===" << endl << endl;
+
+    // Test Case 1: sample tree from verticalTravers.cpp
+    //         3
+    //        / \
+    //       9   20
+    //          /  \
+    //         15   7
+    cout << "Test Case 1 (sample tree, all queries vs reference):" << endl;
+    TreeNode* root1 = new TreeNode(3);
+    root1->left = new TreeNode(9);
+    root1->right = new TreeNode(20);
+    root1->right->left = new TreeNode(15);
+    root1->right->right = new TreeNode(7);
+    cout << (matchesReference(root1) ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+    deleteTree(root1);
+
+    // Test Case 2: empty tree
+    cout << "Test Case 2 (empty tree):" << endl;
+    cout << (matchesReference(nullptr) ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: random trees of many sizes
+    cout << "Test Case 3 (200 random trees vs reference):" << endl;
+    bool allOk = true;
+    for (int t = 0; t < 200; t++) {
+        TreeNode* root = buildRandomTree(1 + t * 7, t);
+        allOk &= matchesReference(root);
+        deleteTree(root);
+    }
+    cout << (allOk ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: steady-state queries do not allocate
+    cout << "Test Case 4 (zero allocations after warm-up):" << endl;
+    TreeNode* big = buildRandomTree(200000, 42);
+    ContextSolution sol;
+    QueryContext& ctx = threadContext();
+    runAllQueries(sol, big, ctx);  // warm-up sizes the buffers
+    long long before = g_alloc.allocations.load();
+    for (int i = 0; i < 5; i++)
+        runAllQueries(sol, big, ctx);
+    long long allocs = g_alloc.allocations.load() - before;
+    cout << "Allocations during 5 rounds of 6 queries: " << allocs << endl;
+    cout << "Expected: 0" << endl;
+    cout << (allocs == 0 ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 5: many reader threads on the same immutable tree
+    cout << "Test Case 5 (concurrent readers, checksums vs reference):" << endl;
+    const long long expected = referenceChecksum(big);
+    bool checksumsOk = true;
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores * 2; threads *= 2) {
+        const int rounds = 4;
+        atomic<long long> checksum(0);
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                ContextSolution local;
+                QueryContext& mine = threadContext();
+                long long sum = 0;
+                for (int r = 0; r < rounds; r++)
+                    sum += runAllQueries(local, big, mine);
+                checksum += sum;
+            });
+        }
+        for (auto& w : workers) w.join();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << "  threads=" << threads << "  queries=" << threads * rounds * 6
+             << "  time=" << ms << " ms  checksum=" << checksum.load() << endl;
+        checksumsOk &= checksum.load() == expected * threads * rounds;
+    }
+    cout << "Expected checksum per query round: " << expected << endl;
+    cout << (checksumsOk ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+    deleteTree(big);
+
+    cout << "=== All Test Cases Completed ===" << endl;
+    return 0;
+}
+
+/*
+==================== KEY INSIGHTS ====================
+
+1. Why a context object instead of member buffers in Solution?
+   - A Solution shared between threads would need a lock around its buffers
+   - One context per thread keeps the shared data (the tree) read-only and
+     the mutable data (scratch) private, so there is nothing to synchronize
+
+2. Why vectors instead of queue<TreeNode*>?
+   - std::queue (deque) frees and reallocates blocks as it drains and refills
+   - Two vectors swapped per level (or one vector with a head index) keep
+     their capacity forever
+
+3. Vertical traversal without maps:
+   - Sorting (column, row, value) tuples gives the same order as
+     map -> map -> multiset, and sort() works in place
+*/
@@ -0,0 +1,621 @@
+/**
+ * Tree Ingestion from Level-Order Text and Binary Streams
+ *
+ * Problem: Trees are only built by hand (newNode, createSampleTree, chains of
+ * root->left = new TreeNode(...)), but real inputs arrive as huge LeetCode-style
+ * level-order dumps "[1,2,null,3,...]" or as binary int streams, often several
+ * GB in size.
+ *
+ * Approach: Streaming parser that builds straight into a node arena
+ * - NodeArena hands out TreeNodes from blocks of ARENA_BLOCK nodes. Nodes never
+ *   move, so the pointers stay valid, and one allocation serves 64K nodes
+ * - LevelOrderBuilder attaches each token to the next free child slot
+ *   (left, then right, of the oldest parent still waiting). Parents that are
+ *   finished are dropped from the front of its queue now and then, so memory
+ *   does not grow with the input beyond the nodes themselves
+ * - Text is read with fread in fixed chunks, not iostreams. A token that
+ *   crosses a chunk boundary is carried into the next chunk. Digit runs are
+ *   found 16 bytes at a time with SSE2 (compare, movemask, count trailing
+ *   zeros), then converted in one multiply-add loop of known length
+ * - Binary format: little-endian int32 values in level order; INT32_MIN
+ *   (0x80000000) stands for null
+ * - IngestStats reports bytes, nodes and MB/s. Malformed input (a value with
+ *   no free parent slot, a bad token, a token not followed by a separator, a
+ *   number outside int range, any character other than digits, '-', "null",
+ *   brackets, commas and whitespace, a binary stream that ends inside a
+ *   value) sets IngestStats::error and parsing stops
+ *
+ * The result is a plain TreeNode*, so every existing Solution runs on it as is.
+ *
+ * Time Complexity: O(input bytes)
+ * Space Complexity: O(N) nodes + O(width) pending parents + one chunk buffer
+ *
+ * Usage: ./tree_ingest [file]   (.bin = binary stream, anything else = text)
+ * Build: g++ -std=c++17 -O2 tree_ingest.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <map>
+#include <set>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <emmintrin.h>
+using namespace std;
+
+const size_t ARENA_BLOCK = 1 << 16;   // nodes per arena block
+const size_t READ_CHUNK = 1 << 20;    // bytes per fread
+const size_t TOKEN_LOOKAHEAD = 32;    // longest token we must see whole ("-2147483648" + slack)
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+// ==================== NODE ARENA ====================
+
+class NodeArena {
+public:
+    TreeNode* make(int val) {
+        if (used == ARENA_BLOCK) {
+            blocks.emplace_back(new TreeNode[ARENA_BLOCK]);
+            used = 0;
+        }
+        TreeNode* node = &blocks.back()[used++];
+        *node = TreeNode(val);
+        return node;
+    }
+
+    size_t size() const { return blocks.empty() ? 0 : (blocks.size() - 1) * ARENA_BLOCK + used; }
+
+private:
+    vector<unique_ptr<TreeNode[]>> blocks;
+    size_t used = ARENA_BLOCK;
+};
+
+// ==================== LEVEL-ORDER BUILDER ====================
+
+struct IngestStats {
+    size_t bytes = 0;
+    size_t nodes = 0;
+    double seconds = 0;
+    string error;  // empty on success
+
+    double mbPerSecond() const { return seconds > 0 ? bytes / 1e6 / seconds : 0; }
+};
+
+class LevelOrderBuilder {
+public:
+    explicit LevelOrderBuilder(NodeArena& arena) : arena(arena) {}
+
+    // Next token in level order; false if the token has nowhere to go
+    bool add(int value) { return attach(arena.make(value)); }
+    bool addNull() { return attach(nullptr); }
+
+    TreeNode* root() const { return rootNode; }
+    size_t nodes() const { return nodeCount; }
+
+private:
+    NodeArena& arena;
+    TreeNode* rootNode = nullptr;
+    bool seenRoot = false;
+    vector<TreeNode*> pending;  // parents in level order; [head, end) still have free slots
+    size_t head = 0;
+    bool rightNext = false;
+    size_t nodeCount = 0;
+
+    bool attach(TreeNode* node) {
+        if (node) nodeCount++;
+        if (!seenRoot) {
+            seenRoot = true;
+            rootNode = node;
+            if (node) pending.push_back(node);
+            return true;
+        }
+        if (head == pending.size())
+            return node == nullptr;  // trailing nulls are fine, values are not
+
+        TreeNode* parent = pending[head];
+        (rightNext ? parent->right : parent->left) = node;
+        if (rightNext) head++;
+        rightNext = !rightNext;
+        if (node) pending.push_back(node);
+
+        // Drop finished parents once they make up half of the queue
+        if (head >= 4096 && head * 2 >= pending.size()) {
+            pending.erase(pending.begin(), pending.begin() + head);
+            head = 0;
+        }
+        return true;
+    }
+};
+
+// ==================== TEXT PARSER ====================
+
+/**
+ * Number of consecutive ASCII digits at p (at most 16); p must have 16 readable bytes
+ */
+inline int digitRun(const char* p) {
+    __m128i c = _mm_loadu_si128((const __m128i*)p);
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    unsigned notDigit = ~(unsigned)_mm_movemask_epi8(isDigit);
+    return __builtin_ctz(notDigit);  // bit 16 and up are always set
+}
+
+/** Characters that may end a value or null token (0 is the padding past end of input) */
+inline bool endsToken(char c) {
+    return c == ',' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == 0;
+}
+
+/**
+ * Parses "[v0,v1,null,...]" from in into arena; separators may be any mix of
+ * commas, spaces and newlines. chunk is the fread size (>= 64).
+ */
+TreeNode* parseLevelOrder(FILE* in, NodeArena& arena, IngestStats& stats, size_t chunk = READ_CHUNK) {
+    auto start = chrono::steady_clock::now();
+    LevelOrderBuilder builder(arena);
+    vector<char> buf(chunk + TOKEN_LOOKAHEAD + 16);
+    size_t len = 0, pos = 0;
+    bool eof = false;
+
+    while (stats.error.empty()) {
+        // Refill: keep the unread tail, append the next chunk, pad with zeros
+        if (!eof && len - pos < TOKEN_LOOKAHEAD) {
+            memmove(buf.data(), buf.data() + pos, len - pos);
+            len -= pos;
+            pos = 0;
+            size_t got = fread(buf.data() + len, 1, chunk - len, in);
+            stats.bytes += got;
+            len += got;
+            eof = got == 0;
+            memset(buf.data() + len, 0, buf.size() - len);
+        }
+        if (pos >= len) break;
+
+        // Consume tokens while a whole token is guaranteed to be in the buffer
+        while (pos < len && (eof || len - pos >= TOKEN_LOOKAHEAD)) {
+            const char* p = buf.data() + pos;
+            char c = *p;
+            if ((unsigned)(c - '0') < 10 || c == '-') {
+                bool negative = c == '-';
+                int run = digitRun(p + negative);
+                if (run == 0 || run > 10) {
+                    stats.error = "bad number at byte " + to_string(stats.bytes - (len - pos));
+                    break;
+                }
+                if (!endsToken(p[negative + run])) {
+                    stats.error = "missing separator at byte " + to_string(stats.bytes - (len - pos) + negative + run);
+                    break;
+                }
+                long long value = 0;
+                for (int i = 0; i < run; i++)
+                    value = value * 10 + (p[negative + i] - '0');
+                if (negative) value = -value;
+                if (value < INT_MIN || value > INT_MAX) {
+                    stats.error = "number out of int range at byte " + to_string(stats.bytes - (len - pos));
+                    break;
+                }
+                if (!builder.add((int)value)) {
+                    stats.error = "value with no free parent slot";
+                    break;
+                }
+                pos += negative + run;
+            } else if (c == 'n') {
+                if (memcmp(p, "null", 4) != 0) {
+                    stats.error = "bad token at byte " + to_string(stats.bytes - (len - pos));
+                    break;
+                }
+                if (!endsToken(p[4])) {
+                    stats.error = "missing separator at byte " + to_string(stats.bytes - (len - pos) + 4);
+                    break;
+                }
+                builder.addNull();
+                pos += 4;
+            } else if (c == '[' || c == ']' || c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                pos++;
+            } else {
+                stats.error = "unexpected character at byte " + to_string(stats.bytes - (len - pos));
+                break;
+            }
+        }
+    }
+
+    stats.nodes = builder.nodes();
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return stats.error.empty() ? builder.root() : nullptr;
+}
+
+// ==================== BINARY PARSER ====================
+
+const int32_t BINARY_NULL = INT32_MIN;
+
+/**
+ * Parses a little-endian int32 level-order stream (BINARY_NULL = null). Reads
+ * bytes, so a value split across reads is carried over and a stream that ends
+ * inside a value is an error, not a silently dropped tail
+ */
+TreeNode* parseBinary(FILE* in, NodeArena& arena, IngestStats& stats, size_t chunk = READ_CHUNK) {
+    auto start = chrono::steady_clock::now();
+    LevelOrderBuilder builder(arena);
+    vector<char> buf(max(sizeof(int32_t), chunk / sizeof(int32_t) * sizeof(int32_t)));
+
+    size_t carry = 0, got;  // carry: bytes of an incomplete value at the front of buf
+    while (stats.error.empty() && (got = fread(buf.data() + carry, 1, buf.size() - carry, in)) > 0) {
+        stats.bytes += got;
+        size_t total = carry + got, whole = total / sizeof(int32_t);
+        for (size_t i = 0; i < whole; i++) {
+            int32_t value;
+            memcpy(&value, buf.data() + i * sizeof(int32_t), sizeof(int32_t));
+            bool ok = value == BINARY_NULL ? builder.addNull() : builder.add(value);
+            if (!ok) {
+                stats.error = "value with no free parent slot";
+                break;
+            }
+        }
+        carry = total - whole * sizeof(int32_t);
+        memmove(buf.data(), buf.data() + whole * sizeof(int32_t), carry);
+    }
+    if (stats.error.empty() && carry)
+        stats.error = "truncated value at byte " + to_string(stats.bytes - carry);
+
+    stats.nodes = builder.nodes();
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return stats.error.empty() ? builder.root() : nullptr;
+}
+
+// ==================== REFERENCE SOLUTIONS (unchanged algorithms) ====================
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left) q.push(node->left);
+                if (node->right) q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<vector<int>> verticalTraversal(TreeNode* root) {
+        if (!root) return {};
+
+        map<int, map<int, multiset<int>>> nodes;
+        queue<pair<TreeNode*, pair<int, int>>> todo;
+        todo.push({root, {0, 0}});
+
+        while (!todo.empty()) {
+            auto p = todo.front();
+            todo.pop();
+            TreeNode* node = p.first;
+            int x = p.second.first;
+            int y = p.second.second;
+            nodes[x][y].insert(node->val);
+            if (node->left) todo.push({node->left, {x - 1, y + 1}});
+            if (node->right) todo.push({node->right, {x + 1, y + 1}});
+        }
+
+        vector<vector<int>> answer;
+        for (auto p : nodes) {
+            vector<int> col;
+            for (auto q : p.second)
+                col.insert(col.end(), q.second.begin(), q.second.end());
+            answer.push_back(col);
+        }
+        return answer;
+    }
+
+    vector<int> boundaryTraversal(TreeNode* root) {
+        vector<int> result;
+        if (!root) return result;
+        if (!isLeaf(root)) result.push_back(root->val);
+
+        for (TreeNode* curr = root->left; curr; curr = curr->left ? curr->left : curr->right)
+            if (!isLeaf(curr)) result.push_back(curr->val);
+
+        addLeaves(root, result);
+
+        vector<int> temp;
+        for (TreeNode* curr = root->right; curr; curr = curr->right ? curr->right : curr->left)
+            if (!isLeaf(curr)) temp.push_back(curr->val);
+        for (int i = (int)temp.size() - 1; i >= 0; i--)
+            result.push_back(temp[i]);
+        return result;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL) return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL) return 0;
+        int lh = depth(root->left, diameter);
+        int rh = depth(root->right, diameter);
+        diameter = max(diameter, lh + rh);
+        return 1 + max(lh, rh);
+    }
+
+    void recursion(TreeNode* root, int level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == (int)result.size()) result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+
+    bool isLeaf(TreeNode* node) {
+        return !node->left && !node->right;
+    }
+
+    void addLeaves(TreeNode* root, vector<int>& result) {
+        if (isLeaf(root)) {
+            result.push_back(root->val);
+            return;
+        }
+        if (root->left) addLeaves(root->left, result);
+        if (root->right) addLeaves(root->right, result);
+    }
+};
+
+// ==================== UTILITY FUNCTIONS FOR TESTING ====================
+
+// Level-order serialization with trailing nulls trimmed (LeetCode format)
+void serialize(TreeNode* root, FILE* text, FILE* binary) {
+    vector<TreeNode*> order;
+    if (root) order.push_back(root);
+    for (size_t i = 0; i < order.size(); i++) {
+        if (!order[i]) continue;
+        order.push_back(order[i]->left);
+        order.push_back(order[i]->right);
+    }
+    while (!order.empty() && !order.back()) order.pop_back();
+
+    if (text) fputc('[', text);
+    for (size_t i = 0; i < order.size(); i++) {
+        if (text) {
+            if (i) fputc(',', text);
+            if (order[i]) fprintf(text, "%d", order[i]->val);
+            else fputs("null", text);
+        }
+        if (binary) {
+            int32_t v = order[i] ? order[i]->val : BINARY_NULL;
+            fwrite(&v, sizeof(v), 1, binary);
+        }
+    }
+    if (text) fputc(']', text);
+}
+
+string toText(TreeNode* root) {
+    FILE* f = tmpfile();
+    serialize(root, f, nullptr);
+    string s(ftell(f), '\0');
+    rewind(f);
+    size_t got = fread(&s[0], 1, s.size(), f);
+    s.resize(got);
+    fclose(f);
+    return s;
+}
+
+TreeNode* parseString(const string& text, NodeArena& arena, IngestStats& stats, size_t chunk = READ_CHUNK) {
+    FILE* f = tmpfile();
+    fwrite(text.data(), 1, text.size(), f);
+    rewind(f);
+    TreeNode* root = parseLevelOrder(f, arena, stats, chunk);
+    fclose(f);
+    return root;
+}
+
+// Random tree with values in [-range, range]: each node hangs off a random free slot
+TreeNode* randomTree(int n, int range, mt19937& rng, NodeArena& arena) {
+    if (n == 0) return nullptr;
+    TreeNode* root = arena.make((int)(rng() % (2 * range + 1)) - range);
+    vector<TreeNode**> slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        TreeNode* node = arena.make((int)(rng() % (2 * range + 1)) - range);
+        *slots[s] = node;
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&node->left);
+        slots.push_back(&node->right);
+    }
+    return root;
+}
+
+bool sameAnswers(Solution& s, TreeNode* a, TreeNode* b) {
+    if (!a || !b) return a == b;
+    return s.maxPathSum(a) == s.maxPathSum(b) && s.diameterOfBinaryTree(a) == s.diameterOfBinaryTree(b) &&
+           s.rightSideView(a) == s.rightSideView(b) && s.zigzagLevelOrder(a) == s.zigzagLevelOrder(b) &&
+           s.verticalTraversal(a) == s.verticalTraversal(b) && s.boundaryTraversal(a) == s.boundaryTraversal(b);
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+int main(int argc, char* argv[]) {
+    Solution solution;
+
+    // Ingest a file given on the command line and stop
+    if (argc > 1) {
+        string path = argv[1];
+        bool binary = path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) {
+            cout << "cannot open " << path << endl;
+            return 1;
+        }
+        NodeArena arena;
+        IngestStats stats;
+        TreeNode* root = binary ? parseBinary(f, arena, stats) : parseLevelOrder(f, arena, stats);
+        fclose(f);
+        if (!stats.error.empty()) {
+            cout << "parse error: " << stats.error << endl;
+            return 1;
+        }
+        cout << stats.nodes << " nodes, " << stats.bytes / 1e6 << " MB in " << stats.seconds * 1000
+             << " ms (" << stats.mbPerSecond() << " MB/s)" << endl;
+        cout << "right side view length: " << solution.rightSideView(root).size() << endl;
+        return 0;
+    }
+
+    // Test Case 1: [-10,9,20,null,null,15,7] through every Solution query
+    cout << "Test Case 1:" << endl;
+    NodeArena arena;
+    IngestStats stats;
+    TreeNode* root = parseString("[-10,9,20,null,null,15,7]", arena, stats);
+    cout << "Parsed back: " << toText(root) << endl;
+    cout << "maxPathSum=" << solution.maxPathSum(root) << " diameter=" << solution.diameterOfBinaryTree(root)
+         << " rightSideView size=" << solution.rightSideView(root).size()
+         << " zigzag levels=" << solution.zigzagLevelOrder(root).size()
+         << " vertical columns=" << solution.verticalTraversal(root).size()
+         << " boundary size=" << solution.boundaryTraversal(root).size() << endl;
+    cout << "Expected: maxPathSum=42 diameter=3 rightSideView size=3 zigzag levels=3 vertical columns=4 boundary size=5"
+         << endl << endl;
+
+    // Test Case 2: edge cases and malformed input
+    cout << "Test Case 2 (edge cases):" << endl;
+    bool ok = true;
+    IngestStats s1, s2, s3, s4, s5, s6, s7, s8, s9, s10;
+    ok &= parseString("[]", arena, s1) == nullptr && s1.error.empty();
+    ok &= toText(parseString(" [ 1 ,\n null , -2147483648 , null , null ] ", arena, s2)) == "[1,null,-2147483648]";
+    ok &= parseString("[1,null,null,5]", arena, s3) == nullptr && !s3.error.empty();
+    ok &= parseString("[1,nul]", arena, s4) == nullptr && !s4.error.empty();
+    ok &= parseString("[1,2147483648]", arena, s5) == nullptr && !s5.error.empty();
+    ok &= parseString("[-2147483649]", arena, s6) == nullptr && !s6.error.empty();
+    ok &= parseString("[1;2]", arena, s7) == nullptr && !s7.error.empty();
+    ok &= parseString("[1,2null,3]", arena, s8) == nullptr && !s8.error.empty();
+    ok &= parseString("[1,nullnull]", arena, s9) == nullptr && !s9.error.empty();
+    // 9 bytes: two whole values and one byte of a third
+    FILE* partial = tmpfile();
+    int32_t two[2] = {1, 2};
+    fwrite(two, sizeof(int32_t), 2, partial);
+    fputc(3, partial);
+    rewind(partial);
+    ok &= parseBinary(partial, arena, s10) == nullptr && s10.error == "truncated value at byte 8" && s10.bytes == 9;
+    fclose(partial);
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << "  (errors: \"" << s3.error << "\", \"" << s4.error << "\", \""
+         << s5.error << "\", \"" << s7.error << "\", \"" << s8.error << "\", \"" << s10.error << "\")" << endl
+         << endl;
+
+    // Test Case 3: round trips through text (tiny chunks: tokens split across reads) and binary
+    cout << "Test Case 3 (round trip, all six queries agree):" << endl;
+    mt19937 rng(41);
+    ok = true;
+    for (int t = 0; t < 200; t++) {
+        NodeArena local;
+        TreeNode* original = randomTree(rng() % 300, (t % 2) ? 5 : 2000000000, rng, local);
+        string text = toText(original);
+
+        IngestStats textStats, binStats;
+        TreeNode* fromText = parseString(text, local, textStats, 64 + rng() % 64);
+
+        FILE* bin = tmpfile();
+        serialize(original, nullptr, bin);
+        rewind(bin);
+        TreeNode* fromBinary = parseBinary(bin, local, binStats, 4 * (1 + rng() % 16));
+        fclose(bin);
+
+        ok &= textStats.error.empty() && binStats.error.empty();
+        ok &= toText(fromText) == text && toText(fromBinary) == text;
+        ok &= sameAnswers(solution, original, fromText) && sameAnswers(solution, original, fromBinary);
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: throughput on a 2^22-node tree
+    cout << "Test Case 4 (throughput, 2^22 nodes):" << endl;
+    NodeArena bigArena;
+    TreeNode* big = randomTree(1 << 22, 1000000000, rng, bigArena);
+    FILE* text = tmpfile();
+    FILE* binary = tmpfile();
+    serialize(big, text, binary);
+
+    rewind(text);
+    NodeArena textArena;
+    IngestStats textStats;
+    TreeNode* fromText = parseLevelOrder(text, textArena, textStats);
+
+    rewind(binary);
+    NodeArena binArena;
+    IngestStats binStats;
+    TreeNode* fromBinary = parseBinary(binary, binArena, binStats);
+
+    // Baseline: whole file into a string, then istringstream + getline + stoi
+    rewind(text);
+    auto start = chrono::steady_clock::now();
+    string all(textStats.bytes, '\0');
+    size_t got = fread(&all[0], 1, all.size(), text);
+    istringstream in(all.substr(1, got - 2));
+    string token;
+    size_t baselineNodes = 0;
+    while (getline(in, token, ','))
+        if (token != "null") {
+            volatile int v = stoi(token);
+            (void)v;
+            baselineNodes++;
+        }
+    double baselineSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    fclose(text);
+    fclose(binary);
+
+    cout << "  text:   " << textStats.bytes / 1e6 << " MB, " << textStats.mbPerSecond() << " MB/s" << endl;
+    cout << "  binary: " << binStats.bytes / 1e6 << " MB, " << binStats.mbPerSecond() << " MB/s" << endl;
+    cout << "  istringstream + stoi (tokenize only): " << textStats.bytes / 1e6 / baselineSeconds << " MB/s" << endl;
+    ok = textStats.nodes == (1u << 22) && binStats.nodes == (1u << 22) && baselineNodes == (1u << 22);
+    ok &= solution.rightSideView(fromText) == solution.rightSideView(big);
+    ok &= solution.rightSideView(fromBinary) == solution.rightSideView(big);
+    cout << "  trees match: " << (ok ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    return 0;
+}
@@ -0,0 +1,461 @@
+/**
+ * Tree Relayout (preorder / BFS / van Emde Boas node ordering)
+ *
+ * Problem: Trees built with newNode() end up wherever malloc puts each node,
+ * so maxPath, depth and addLeaves miss the cache on almost every node they
+ * visit.
+ *
+ * Approach: Copy the tree into one contiguous block in a chosen order
+ * - relayout(root, layout) returns a RelaidTree: a vector<TreeNode> holding
+ *   every node, with left / right rewired to point inside the block. Its
+ *   root() is an ordinary TreeNode*, so every existing Solution runs on it
+ *   unchanged
+ * - Layout::Preorder: node, left subtree, right subtree. A DFS such as maxPath
+ *   or depth reads memory almost sequentially
+ * - Layout::BFS: level by level. Level-order algorithms (zigzag, side view)
+ *   read memory sequentially
+ * - Layout::VanEmdeBoas: cut the tree at half its height, lay out the top
+ *   part recursively, then each bottom subtree recursively. Any root-to-leaf
+ *   path touches O(log_B n) cache lines for every block size B, so this
+ *   layout suits a mix of both access patterns
+ * - The orders are computed with explicit stacks, so deep or skewed trees
+ *   cannot overflow the call stack
+ *
+ * The benchmark reports, for each layout, time and cache misses per algorithm:
+ * hardware counts from perf_event_open when the kernel allows it, and always a
+ * simulated count (a 256 KB 8-way LRU cache with 64-byte lines replaying the
+ * algorithm's node visit order).
+ *
+ * Time Complexity: relayout O(N) (O(N log H) for van Emde Boas)
+ * Space Complexity: O(N) for the new block
+ *
+ * Usage: ./tree_relayout [nodes]   (default 2^20)
+ * Build: g++ -std=c++17 -O2 tree_relayout.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <list>
+#include <string>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+using namespace std;
+
+// Definition for a binary tree node
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+
+    // Constructors
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+enum class Layout { Preorder, BFS, VanEmdeBoas };
+
+// ==================== NODE ORDERS ====================
+
+vector<TreeNode*> preorder(TreeNode* root) {
+    vector<TreeNode*> order, stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+        order.push_back(node);
+        if (node->right) stack.push_back(node->right);
+        if (node->left) stack.push_back(node->left);
+    }
+    return order;
+}
+
+vector<TreeNode*> bfsOrder(TreeNode* root) {
+    vector<TreeNode*> order;
+    if (root) order.push_back(root);
+    for (size_t i = 0; i < order.size(); i++) {
+        if (order[i]->left) order.push_back(order[i]->left);
+        if (order[i]->right) order.push_back(order[i]->right);
+    }
+    return order;
+}
+
+int height(TreeNode* root) {
+    vector<TreeNode*> level;
+    if (root) level.push_back(root);
+    int h = 0;
+    while (!level.empty()) {
+        vector<TreeNode*> next;
+        for (TreeNode* node : level) {
+            if (node->left) next.push_back(node->left);
+            if (node->right) next.push_back(node->right);
+        }
+        level.swap(next);
+        h++;
+    }
+    return h;
+}
+
+/**
+ * van Emde Boas order. A task (node, h) lays out the first h levels below
+ * node: the top ceil(h/2) levels recursively, then each subtree hanging
+ * below them, again with the remaining h/2 levels
+ */
+vector<TreeNode*> vebOrder(TreeNode* root) {
+    vector<TreeNode*> order;
+    vector<pair<TreeNode*, int>> tasks;
+    if (root) tasks.push_back({root, height(root)});
+
+    while (!tasks.empty()) {
+        TreeNode* node = tasks.back().first;
+        int h = tasks.back().second;
+        tasks.pop_back();
+
+        if (h == 1) {
+            order.push_back(node);
+            continue;
+        }
+
+        int top = (h + 1) / 2;
+        // Roots of the bottom subtrees: nodes exactly `top` levels below node
+        vector<TreeNode*> frontier = {node};
+        for (int d = 0; d < top && !frontier.empty(); d++) {
+            vector<TreeNode*> next;
+            for (TreeNode* n : frontier) {
+                if (n->left) next.push_back(n->left);
+                if (n->right) next.push_back(n->right);
+            }
+            frontier.swap(next);
+        }
+
+        // Tasks run last-in first-out: push the bottoms in reverse, then the top
+        for (auto it = frontier.rbegin(); it != frontier.rend(); ++it)
+            tasks.push_back({*it, h - top});
+        tasks.push_back({node, top});
+    }
+    return order;
+}
+
+// ==================== RELAYOUT ====================
+
+class RelaidTree {
+public:
+    RelaidTree() = default;
+    RelaidTree(RelaidTree&&) = default;
+    RelaidTree& operator=(RelaidTree&&) = default;
+    RelaidTree(const RelaidTree&) = delete;  // copies would point into the old block
+
+    TreeNode* root() { return nodes.empty() ? nullptr : &nodes[0]; }
+    size_t size() const { return nodes.size(); }
+
+private:
+    vector<TreeNode> nodes;  // contiguous; nodes[0] is the root
+    friend RelaidTree relayout(TreeNode* root, Layout layout);
+};
+
+/**
+ * Copies the tree into one contiguous block in the given order.
+ * The original tree is not modified.
+ */
+RelaidTree relayout(TreeNode* root, Layout layout) {
+    vector<TreeNode*> order = layout == Layout::Preorder ? preorder(root)
+                            : layout == Layout::BFS      ? bfsOrder(root)
+                                                         : vebOrder(root);
+    unordered_map<TreeNode*, TreeNode*> moved;
+    moved.reserve(order.size());
+
+    RelaidTree tree;
+    tree.nodes.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+        moved[order[i]] = &tree.nodes[i];
+    moved[nullptr] = nullptr;
+
+    for (size_t i = 0; i < order.size(); i++)
+        tree.nodes[i] = TreeNode(order[i]->val, moved[order[i]->left], moved[order[i]->right]);
+    return tree;
+}
+
+// ==================== BENCHMARK ALGORITHMS ====================
+
+class Solution {
+public:
+    int maxPathSum(TreeNode* root) {
+        int maxi = INT_MIN;
+        maxPath(root, maxi);
+        return maxi;
+    }
+
+    int diameterOfBinaryTree(TreeNode* root) {
+        int diameter = 0;
+        depth(root, diameter);
+        return diameter;
+    }
+
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left)
+                    q.push(node->left);
+                if (node->right)
+                    q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+private:
+    int maxPath(TreeNode* root, int& maxi) {
+        if (root == NULL)
+            return 0;
+        int leftSum = max(0, maxPath(root->left, maxi));
+        int rightSum = max(0, maxPath(root->right, maxi));
+        maxi = max(maxi, leftSum + rightSum + root->val);
+        return root->val + max(leftSum, rightSum);
+    }
+
+    int depth(TreeNode* root, int& diameter) {
+        if (root == NULL)
+            return 0;
+        int leftDepth = depth(root->left, diameter);
+        int rightDepth = depth(root->right, diameter);
+        diameter = max(diameter, leftDepth + rightDepth);
+        return 1 + max(leftDepth, rightDepth);
+    }
+};
+
+// ==================== CACHE MISS COUNTERS ====================
+
+// Hardware cache misses of this thread (user space only); -1 when unavailable
+class MissCounter {
+public:
+    MissCounter() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    ~MissCounter() { if (fd >= 0) close(fd); }
+
+    bool available() const { return fd >= 0; }
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+// Set-associative LRU cache model over 64-byte lines
+class SimulatedCache {
+public:
+    SimulatedCache(size_t bytes = 256 * 1024, int ways = 8) : ways(ways), sets(bytes / 64 / ways), lines(sets) {}
+
+    void touch(const void* p) {
+        uintptr_t line = (uintptr_t)p / 64;
+        list<uintptr_t>& set = lines[line % sets];
+        auto it = find(set.begin(), set.end(), line);
+        if (it != set.end()) {
+            set.splice(set.begin(), set, it);
+            return;
+        }
+        misses++;
+        set.push_front(line);
+        if ((int)set.size() > ways) set.pop_back();
+    }
+
+    long long misses = 0;
+
+private:
+    int ways;
+    size_t sets;
+    vector<list<uintptr_t>> lines;
+};
+
+// Node visit order of the recursive DFS (enter, then revisit after both children)
+long long simulateDfs(TreeNode* root) {
+    SimulatedCache cache;
+    vector<pair<TreeNode*, bool>> stack;
+    if (root) stack.push_back({root, false});
+    while (!stack.empty()) {
+        auto [node, revisit] = stack.back();
+        stack.pop_back();
+        cache.touch(node);
+        if (revisit) continue;
+        stack.push_back({node, true});
+        if (node->right) stack.push_back({node->right, false});
+        if (node->left) stack.push_back({node->left, false});
+    }
+    return cache.misses;
+}
+
+long long simulateBfs(TreeNode* root) {
+    SimulatedCache cache;
+    queue<TreeNode*> q;
+    if (root) q.push(root);
+    while (!q.empty()) {
+        TreeNode* node = q.front();
+        q.pop();
+        cache.touch(node);
+        if (node->left) q.push(node->left);
+        if (node->right) q.push(node->right);
+    }
+    return cache.misses;
+}
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+/**
+ * Random tree whose nodes are allocated in a shuffled order, so parents and
+ * children are scattered across the heap like a long-lived newNode() tree
+ */
+TreeNode* scatteredTree(int n, mt19937& rng, vector<TreeNode*>& pool) {
+    pool.clear();
+    for (int i = 0; i < n; i++) {
+        pool.push_back(new TreeNode((int)(rng() % 2001) - 1000));
+        if (i % 3 == 0) delete[] new char[48 + rng() % 200];  // fragment the heap a little
+    }
+    vector<TreeNode*> shuffled = pool;
+    shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    TreeNode* root = shuffled[0];
+    vector<TreeNode**> slots = {&root->left, &root->right};
+    for (int i = 1; i < n; i++) {
+        size_t s = rng() % slots.size();
+        *slots[s] = shuffled[i];
+        slots[s] = slots.back();
+        slots.pop_back();
+        slots.push_back(&shuffled[i]->left);
+        slots.push_back(&shuffled[i]->right);
+    }
+    return root;
+}
+
+string layoutName(Layout layout) {
+    return layout == Layout::Preorder ? "preorder" : layout == Layout::BFS ? "bfs" : "van Emde Boas";
+}
+
+int main(int argc, char* argv[]) {
+    int nodeCount = (argc > 1) ? atoi(argv[1]) : (1 << 20);
+    Solution solution;
+
+    // Test Case 1: orders of a small tree
+    // Tree:       1
+    //            / \
+    //           2   3
+    //          / \   \
+    //         4   5   6
+    //        /
+    //       7
+    cout << "Test Case 1:" << endl;
+    TreeNode* small = new TreeNode(1, new TreeNode(2, new TreeNode(4, new TreeNode(7), nullptr), new TreeNode(5)),
+                                   new TreeNode(3, nullptr, new TreeNode(6)));
+    for (Layout layout : {Layout::Preorder, Layout::BFS, Layout::VanEmdeBoas}) {
+        RelaidTree tree = relayout(small, layout);
+        cout << "  " << layoutName(layout) << ": ";
+        for (TreeNode* n : bfsOrder(tree.root())) cout << n->val << "@" << (n - tree.root()) << " ";
+        cout << endl;
+    }
+    cout << "Expected (value@slot, listed in BFS order):" << endl;
+    cout << "  preorder: 1@0 2@1 3@5 4@2 5@4 6@6 7@3" << endl;
+    cout << "  bfs: 1@0 2@1 3@2 4@3 5@4 6@5 7@6" << endl;
+    cout << "  van Emde Boas: 1@0 2@1 3@2 4@3 5@5 6@6 7@4" << endl << endl;
+
+    // Test Case 2: every algorithm gives the same answer on every layout
+    cout << "Test Case 2 (results unchanged after relayout):" << endl;
+    mt19937 rng(38);
+    bool ok = true;
+    vector<TreeNode*> pool;
+    for (int t = 0; t < 200; t++) {
+        TreeNode* root = scatteredTree(1 + rng() % 2000, rng, pool);
+        for (Layout layout : {Layout::Preorder, Layout::BFS, Layout::VanEmdeBoas}) {
+            RelaidTree tree = relayout(root, layout);
+            ok &= tree.size() == pool.size();
+            ok &= solution.maxPathSum(tree.root()) == solution.maxPathSum(root);
+            ok &= solution.diameterOfBinaryTree(tree.root()) == solution.diameterOfBinaryTree(root);
+            ok &= solution.zigzagLevelOrder(tree.root()) == solution.zigzagLevelOrder(root);
+        }
+        for (TreeNode* n : pool) delete n;
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: cache behaviour before and after
+    cout << "Test Case 3 (benchmark, " << nodeCount << " scattered nodes):" << endl;
+    TreeNode* root = scatteredTree(nodeCount, rng, pool);
+    MissCounter counter;
+    if (!counter.available())
+        cout << "  (hardware counters unavailable here, showing simulated misses only)" << endl;
+
+    auto report = [&](const string& name, TreeNode* r) {
+        cout << "  " << name << ":" << endl;
+        long long sink = 0;
+        for (int algo = 0; algo < 3; algo++) {
+            counter.start();
+            auto start = chrono::steady_clock::now();
+            if (algo == 0) sink += solution.maxPathSum(r);
+            else if (algo == 1) sink += solution.diameterOfBinaryTree(r);
+            else sink += solution.zigzagLevelOrder(r).size();
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            long long hw = counter.stop();
+
+            long long simulated = (algo < 2) ? simulateDfs(r) : simulateBfs(r);
+            const char* names[] = {"maxPathSum", "diameter", "zigzag"};
+            cout << "    " << names[algo] << ": " << ms << " ms, simulated misses " << simulated;
+            if (hw >= 0) cout << ", hardware misses " << hw;
+            cout << endl;
+        }
+        return sink;
+    };
+
+    long long expected = report("original (malloc order)", root);
+    for (Layout layout : {Layout::Preorder, Layout::BFS, Layout::VanEmdeBoas}) {
+        auto start = chrono::steady_clock::now();
+        RelaidTree tree = relayout(root, layout);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        long long got = report(layoutName(layout) + " (relayout " + to_string((int)ms) + " ms)", tree.root());
+        if (got != expected) cout << "    RESULTS DIFFER ✗" << endl;
+    }
+
+    for (TreeNode* n : pool) delete n;
+    return 0;
+}
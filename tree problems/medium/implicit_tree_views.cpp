@@ -0,0 +1,273 @@
+/**
+ * Zigzag Level Order and Right Side View on Implicit Complete Trees
+ *
+ * Problem: Many trees are complete binary trees that get built as pointer
+ * TreeNodes just to call zigzagLevelOrder or rightSideView. A complete tree fits
+ * in a plain array (heap layout: the children of i are 2i+1 and 2i+2), and
+ * then neither view needs a queue.
+ *
+ * Approach: Level boundaries are powers of two
+ * - Level L occupies indices [2^L - 1, 2^(L+1) - 1), clipped to n on the last level
+ * - Right side view: the last index of every level
+ * - Zigzag: copy each level forward or reversed, which is a plain
+ *   (reverse) array copy with no per-node branch
+ * - Runtime overloads take (heap, n) for any complete tree and return the same
+ *   shapes as the TreeNode versions
+ * - Fixed-depth overloads take a PerfectTree<Depth> (std::array). Every level's
+ *   start and width are compile-time constants, so the loops unroll and
+ *   vectorize, and both views are constexpr. zigzagLevelOrder returns one flat
+ *   array in level order, where level L starts at levelStart(L)
+ *
+ * Time Complexity: O(N) zigzag, O(log N) right side view
+ * Space Complexity: O(1) beyond the output
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <queue>
+#include <utility>
+#include <chrono>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+// ==================== REFERENCE (TreeNode versions) ====================
+
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+class Solution {
+public:
+    vector<vector<int>> zigzagLevelOrder(TreeNode* root) {
+        vector<vector<int>> result;
+        if (root == NULL)
+            return result;
+
+        queue<TreeNode*> q;
+        q.push(root);
+        bool leftToRight = true;
+
+        while (!q.empty()) {
+            int size = q.size();
+            vector<int> level(size);
+            for (int i = 0; i < size; i++) {
+                TreeNode* node = q.front();
+                q.pop();
+                int index = (leftToRight) ? i : (size - 1 - i);
+                level[index] = node->val;
+                if (node->left)
+                    q.push(node->left);
+                if (node->right)
+                    q.push(node->right);
+            }
+            leftToRight = !leftToRight;
+            result.push_back(level);
+        }
+        return result;
+    }
+
+    vector<int> rightSideView(TreeNode* root) {
+        vector<int> result;
+        recursion(root, 0, result);
+        return result;
+    }
+
+private:
+    void recursion(TreeNode* root, size_t level, vector<int>& result) {
+        if (root == NULL) return;
+        if (level == result.size())
+            result.push_back(root->val);
+        recursion(root->right, level + 1, result);
+        recursion(root->left, level + 1, result);
+    }
+};
+
+// ==================== IMPLICIT LAYOUT (runtime size) ====================
+
+// 64-bit, so levelStart(level + 1) of a last level past 2^30 does not overflow
+constexpr long long levelStart(int level) { return (1LL << level) - 1; }
+
+/**
+ * Zigzag level order of the complete tree heap[0, n)
+ */
+vector<vector<int>> zigzagLevelOrder(const int heap[], int n) {
+    vector<vector<int>> result;
+    for (int level = 0; levelStart(level) < n; level++) {
+        int first = levelStart(level);
+        int last = (int)min<long long>(levelStart(level + 1), n);
+        if (level % 2 == 0)
+            result.emplace_back(heap + first, heap + last);
+        else
+            result.emplace_back(make_reverse_iterator(heap + last), make_reverse_iterator(heap + first));
+    }
+    return result;
+}
+
+/**
+ * Right side view of the complete tree heap[0, n)
+ */
+vector<int> rightSideView(const int heap[], int n) {
+    vector<int> result;
+    for (int level = 0; levelStart(level) < n; level++)
+        result.push_back(heap[min<long long>(levelStart(level + 1), n) - 1]);
+    return result;
+}
+
+// ==================== IMPLICIT LAYOUT (fixed depth) ====================
+
+template <int Depth>
+using PerfectTree = array<int, (1 << Depth) - 1>;
+
+template <int Depth>
+constexpr array<int, Depth> rightSideView(const PerfectTree<Depth>& heap) {
+    array<int, Depth> view{};
+    for (int level = 0; level < Depth; level++)
+        view[level] = heap[levelStart(level + 1) - 1];
+    return view;
+}
+
+// One level with compile-time start and width
+template <int Level, size_t N>
+constexpr void zigzagLevel(const array<int, N>& heap, array<int, N>& out) {
+    constexpr int first = levelStart(Level), width = 1 << Level;
+    if constexpr (Level % 2 == 0) {
+        for (int i = 0; i < width; i++)
+            out[first + i] = heap[first + i];
+    } else {
+        for (int i = 0; i < width; i++)
+            out[first + i] = heap[first + width - 1 - i];
+    }
+}
+
+template <size_t N, int... Levels>
+constexpr void zigzagLevels(const array<int, N>& heap, array<int, N>& out, integer_sequence<int, Levels...>) {
+    (zigzagLevel<Levels>(heap, out), ...);
+}
+
+/**
+ * Zigzag order of a perfect tree, flat: level L is out[levelStart(L), levelStart(L + 1))
+ */
+template <int Depth>
+constexpr PerfectTree<Depth> zigzagLevelOrder(const PerfectTree<Depth>& heap) {
+    PerfectTree<Depth> out{};
+    zigzagLevels(heap, out, make_integer_sequence<int, Depth>{});
+    return out;
+}
+
+// Evaluated entirely by the compiler
+constexpr PerfectTree<3> exampleTree = {1, 2, 3, 4, 5, 6, 7};
+static_assert(rightSideView<3>(exampleTree)[2] == 7);
+static_assert(zigzagLevelOrder<3>(exampleTree)[1] == 3 && zigzagLevelOrder<3>(exampleTree)[2] == 2);
+
+// ==================== MAIN FUNCTION WITH TEST CASES ====================
+
+TreeNode* buildPointerTree(const int heap[], int n, int i = 0) {
+    if (i >= n) return nullptr;
+    return new TreeNode(heap[i], buildPointerTree(heap, n, 2 * i + 1), buildPointerTree(heap, n, 2 * i + 2));
+}
+
+void deleteTree(TreeNode* root) {
+    if (!root) return;
+    deleteTree(root->left);
+    deleteTree(root->right);
+    delete root;
+}
+
+void print2DVector(const vector<vector<int>>& v) {
+    cout << "[";
+    for (size_t i = 0; i < v.size(); i++) {
+        cout << "[";
+        for (size_t j = 0; j < v[i].size(); j++)
+            cout << v[i][j] << (j + 1 < v[i].size() ? "," : "");
+        cout << "]" << (i + 1 < v.size() ? "," : "");
+    }
+    cout << "]" << endl;
+}
+
+int main() {
+    Solution solution;
+
+    // Test Case 1: complete (not perfect) tree [3,9,20,15,7,1]
+    // Tree:       3
+    //            / \
+    //           9   20
+    //          / \  /
+    //         15 7 1
+    cout << "Test Case 1:" << endl;
+    int heap[] = {3, 9, 20, 15, 7, 1};
+    int n = sizeof(heap) / sizeof(heap[0]);
+    cout << "Zigzag: ";
+    print2DVector(zigzagLevelOrder(heap, n));
+    cout << "Right side view: ";
+    for (int x : rightSideView(heap, n)) cout << x << " ";
+    cout << endl << "Expected: [[3],[20,9],[15,7,1]] / 3 20 1" << endl << endl;
+
+    // Test Case 2: runtime overloads vs the TreeNode versions, every size up to 600
+    cout << "Test Case 2 (vs TreeNode zigzagLevelOrder / rightSideView):" << endl;
+    mt19937 rng(39);
+    bool ok = true;
+    for (int size = 0; size <= 600; size++) {
+        vector<int> values(size);
+        for (int& x : values) x = rng() % 1000;
+        TreeNode* root = buildPointerTree(values.data(), size);
+        ok &= zigzagLevelOrder(values.data(), size) == solution.zigzagLevelOrder(root);
+        ok &= rightSideView(values.data(), size) == solution.rightSideView(root);
+        deleteTree(root);
+    }
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 3: fixed-depth overloads vs runtime overloads
+    cout << "Test Case 3 (fixed depth 10 vs runtime):" << endl;
+    PerfectTree<10> perfect;
+    for (int& x : perfect) x = rng() % 1000;
+    PerfectTree<10> flat = zigzagLevelOrder<10>(perfect);
+    vector<vector<int>> nested = zigzagLevelOrder(perfect.data(), perfect.size());
+    ok = true;
+    for (int level = 0; level < 10; level++)
+        ok &= equal(nested[level].begin(), nested[level].end(), flat.begin() + levelStart(level));
+    array<int, 10> view = rightSideView<10>(perfect);
+    ok &= vector<int>(view.begin(), view.end()) == rightSideView(perfect.data(), perfect.size());
+    cout << (ok ? "PASSED ✓" : "FAILED ✗") << endl << endl;
+
+    // Test Case 4: timing over many depth-8 trees
+    const int trees = 20000;
+    cout << "Test Case 4 (timing, " << trees << " perfect trees of depth 8):" << endl;
+    vector<PerfectTree<8>> heaps(trees);
+    vector<TreeNode*> roots(trees);
+    for (int t = 0; t < trees; t++) {
+        for (int& x : heaps[t]) x = rng() % 1000;
+        roots[t] = buildPointerTree(heaps[t].data(), heaps[t].size());
+    }
+
+    long long sums[3] = {0, 0, 0};
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < trees; t++)
+        sums[0] += solution.zigzagLevelOrder(roots[t])[7][0] + solution.rightSideView(roots[t])[7];
+    double pointerMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int t = 0; t < trees; t++)
+        sums[1] += zigzagLevelOrder(heaps[t].data(), heaps[t].size())[7][0] + rightSideView(heaps[t].data(), heaps[t].size())[7];
+    double runtimeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int t = 0; t < trees; t++)
+        sums[2] += zigzagLevelOrder<8>(heaps[t])[levelStart(7)] + rightSideView<8>(heaps[t])[7];
+    double fixedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "  TreeNode + queue: " << pointerMs << " ms" << endl;
+    cout << "  implicit, runtime n: " << runtimeMs << " ms" << endl;
+    cout << "  implicit, fixed depth: " << fixedMs << " ms" << endl;
+    cout << "  results match: " << (sums[0] == sums[1] && sums[1] == sums[2] ? "PASSED ✓" : "FAILED ✗") << endl;
+
+    for (TreeNode* root : roots) deleteTree(root);
+    return 0;
+}